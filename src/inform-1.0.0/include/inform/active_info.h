@@ -4,6 +4,7 @@
 #pragma once
 
 #include <inform/error.h>
+#include <inform/utilities/binning.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -39,6 +40,47 @@ EXPORT double inform_active_info(int const *series, size_t n, size_t m, int b,
 EXPORT double *inform_local_active_info(int const *series, size_t n, size_t m,
     int b, size_t k, double *ai, inform_error *err);
 
+/**
+ * Compute the active information of an ensemble of continuously-valued time
+ * series, binning each value as it is observed.
+ *
+ * The binning specification is fit to the entire ensemble (see
+ * `inform_binning_fit`), and no binned copy of the ensemble is made.
+ *
+ * @param[in] series the ensemble of time series
+ * @param[in] n      the number of initial conditions
+ * @param[in] m      the number of time steps in each time series
+ * @param[in] spec   the binning specification
+ * @param[in] k      the history length used to calculate the active information
+ * @param[out] err   an error structure
+ * @return the active information for the ensemble
+ */
+EXPORT double inform_active_info_binned(double const *series, size_t n,
+    size_t m, inform_binning const *spec, size_t k, inform_error *err);
+
+/**
+ * Compute the active information at each time step of an ensemble of time
+ * series, estimated across the initial conditions rather than over time.
+ *
+ * The value at `ai[t - k]` is the mutual information between the k-histories
+ * ending at time `t - 1` and the states at time `t` of the `n` initial
+ * conditions, for `t` from `k` to `m - 1`, which tracks non-stationary
+ * processes. The series are read in their usual layout, the histograms of
+ * each thread are reused from one time step to the next, and the time steps
+ * are processed in parallel when OpenMP is available.
+ *
+ * @param[in] series the ensemble of time series
+ * @param[in] n      the number of initial conditions
+ * @param[in] m      the number of time steps in each time series
+ * @param[in] b      the base or number of distinct states at each time step
+ * @param[in] k      the history length used to calculate the active information
+ * @param[out] ai    the active information at each time step (allocated if NULL)
+ * @param[out] err   an error structure
+ * @return a pointer to the active information at each time step
+ */
+EXPORT double *inform_active_info_ensemble(int const *series, size_t n,
+    size_t m, int b, size_t k, double *ai, inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,103 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * The strategies for searching the coarse-grainings of a system for the
+ * greatest effective information.
+ */
+typedef enum
+{
+    /// merge disjoint pairs of macro-states in rounds while the EI increases
+    INFORM_EMERGENCE_GREEDY = 0,
+    /// move micro-states between macro-states by simulated annealing
+    INFORM_EMERGENCE_ANNEALED = 1,
+} inform_emergence_mode;
+
+/**
+ * The parameters of a search over coarse-grainings.
+ */
+typedef struct inform_emergence_search
+{
+    /// the search strategy
+    inform_emergence_mode mode;
+    /// the number of moves proposed in each annealing run
+    size_t iterations;
+    /// the number of independent annealing runs
+    size_t restarts;
+    /// the seed of the annealing random number generator
+    uint64_t seed;
+} inform_emergence_search;
+
+/**
+ * Compute the macro-scale transition probability matrix of a coarse-graining
+ * of the states of a system.
+ *
+ * Each micro-state `i` is assigned to the macro-state `groups[i]`, and the
+ * macro-states are numbered `0` to `k - 1`. The transition probability
+ * between two macro-states is the probability of a transition from a
+ * micro-state of the first (each equally likely) to any micro-state of the
+ * second.
+ *
+ * @param[in] tpm    the micro-scale transition probability matrix
+ * @param[in] n      the number of micro-states
+ * @param[in] groups the macro-state of each micro-state
+ * @param[in] k      the number of macro-states
+ * @param[out] macro the macro-scale matrix (allocated if NULL)
+ * @param[out] err   an error code
+ * @return the macro-scale transition probability matrix
+ */
+EXPORT double *inform_macro_tpm(double const *tpm, size_t n,
+    size_t const *groups, size_t k, double *macro, inform_error *err);
+
+/**
+ * Search the coarse-grainings of a system for the one whose macro-scale
+ * transition probability matrix (see `inform_macro_tpm`) has the greatest
+ * effective information under a uniform intervention.
+ *
+ * The macro-scale matrix of the current coarse-graining is kept aggregated in
+ * place, together with the entropy of each of its rows and the sums of its
+ * columns, so that neither the macro-scale matrices nor the effective
+ * information are rebuilt for each candidate:
+ *
+ * - `INFORM_EMERGENCE_GREEDY` starts from the micro-states and merges
+ *   macro-states in rounds. Each round evaluates every pair of macro-states
+ *   (in parallel when OpenMP is available) in time linear in the number of
+ *   macro-states, and takes each macro-state's best improving merge as a
+ *   candidate. The candidates are applied in order of decreasing gain,
+ *   skipping any which share a macro-state with a merge already made in the
+ *   round and undoing any which no longer increase the effective
+ *   information. The search stops after a round without merges. Because a
+ *   round applies several disjoint merges, it can reach a different
+ *   coarse-graining than merging only the single best pair in each round.
+ * - `INFORM_EMERGENCE_ANNEALED` runs `restarts` independent simulated
+ *   annealing searches (in parallel when OpenMP is available), each of which
+ *   proposes `iterations` moves of a micro-state to another macro-state or to
+ *   a new one. Each move is applied and evaluated in time linear in the number
+ *   of micro-states.
+ *
+ * If `search` is `NULL`, the greedy search is used.
+ *
+ * @param[in] tpm    the micro-scale transition probability matrix
+ * @param[in] n      the number of micro-states
+ * @param[in] search the search parameters (or NULL)
+ * @param[out] groups the macro-state of each micro-state of the best
+ *                   coarse-graining, numbered in order of first appearance
+ * @param[out] err   an error code
+ * @return the effective information of the best coarse-graining
+ */
+EXPORT double inform_causal_emergence(double const *tpm, size_t n,
+    inform_emergence_search const *search, size_t *groups, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * The measures of the difference between two distributions computed by
+ * `inform_divergence_matrix`.
+ */
+typedef enum
+{
+    /// the relative entropy (Kullback-Leibler divergence) D(p || q)
+    INFORM_DIVERGENCE_RELATIVE = 0,
+    /// the cross entropy H(p, q)
+    INFORM_DIVERGENCE_CROSS = 1,
+    /// the Jensen-Shannon divergence
+    INFORM_DIVERGENCE_JENSEN_SHANNON = 2,
+} inform_divergence;
+
+/**
+ * Compute a divergence between every one of `np` time series and every one
+ * of `nq` others, each considered as a time series of samples from a
+ * distribution.
+ *
+ * The result is the `np x nq` matrix, stored row by row, whose element
+ * `d[i * nq + j]` is the divergence of the `i`-th series of `ps` from the
+ * `j`-th series of `qs`. As with `inform_relative_entropy` and
+ * `inform_cross_entropy`, the relative entropy is NaN and the cross entropy
+ * infinite if `p` has a state that `q` does not.
+ *
+ * The distribution of each series is built exactly once, densely if the base
+ * is comparable to the length of the series and as a sorted list of the
+ * observed states otherwise, and the pairs are computed in parallel when
+ * OpenMP is available. If `qs` is `ps` (and `nq` is `np`) the distributions
+ * are shared.
+ *
+ * @param[in] ps      the time series of the "true" distributions
+ * @param[in] np      the number of time series in `ps`
+ * @param[in] qs      the time series of the "unnatural" distributions
+ * @param[in] nq      the number of time series in `qs`
+ * @param[in] n       the length of every time series
+ * @param[in] b       the base of the time series
+ * @param[in] measure the divergence to compute
+ * @param[out] d      the divergence matrix (allocated if NULL)
+ * @param[in,out] err the error structure
+ * @return a pointer to the divergence matrix
+ */
+EXPORT double *inform_divergence_matrix(int const *ps, size_t np,
+    int const *qs, size_t nq, size_t n, int b, inform_divergence measure,
+    double *d, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <inform/error.h>
+#include <inform/utilities/tpm.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -24,6 +25,58 @@ extern "C"
 EXPORT double inform_effective_info(double const *tpm, double const *inter,
     size_t n, inform_error *err);
 
+/**
+ * Compute the effective information of an intervention for a sparse transition
+ * probability matrix.
+ *
+ * Only the nonzero transition probabilities are visited, so the cost is
+ * proportional to the number of nonzero entries (and the number of states),
+ * rather than to the square of the number of states.
+ *
+ * If the provided intervention is @c NULL, the uniform distribution is assumed.
+ *
+ * @param[in] tpm   the sparse transition probability matrix
+ * @param[in] inter the intervention distribution (`tpm->size` entries)
+ * @param[out] err  an error code
+ * @return the effective information of the intervention
+ */
+EXPORT double inform_effective_info_sparse(inform_sparse_tpm const *tpm,
+    double const *inter, inform_error *err);
+
+/**
+ * Compute the effective information of an intervention for a Boolean network
+ * given by the update rules of its nodes, without constructing its transition
+ * probability matrix.
+ *
+ * Each node `i` is updated from the `k[i]` nodes listed in `inputs` (the
+ * inputs of all nodes, concatenated), according to a truth table of `2^k[i]`
+ * entries (the tables of all nodes, concatenated) giving the probability that
+ * the node is on. The table is indexed by the encoding of the inputs' states,
+ * with the first input as the most significant bit, and deterministic rules
+ * have tables of zeros and ones. The nodes are updated independently, so each
+ * row of the transition probability matrix is a product of the nodes'
+ * distributions. The states of the network are likewise encoded with the
+ * first node as the most significant bit.
+ *
+ * The state space is streamed over in parallel (when OpenMP is available),
+ * expanding each state's successors over its noisy nodes only, so that the
+ * time is proportional to the number of nonzero transition probabilities and
+ * the memory to the number of states.
+ *
+ * If the provided intervention is @c NULL, the uniform distribution is assumed.
+ *
+ * @param[in] nodes  the number of nodes in the network (at most 30)
+ * @param[in] k      the number of inputs of each node
+ * @param[in] inputs the inputs of each node
+ * @param[in] tables the truth table of each node
+ * @param[in] inter  the intervention distribution (`2^nodes` entries)
+ * @param[out] err   an error code
+ * @return the effective information of the intervention
+ */
+EXPORT double inform_effective_info_boolean(size_t nodes, size_t const *k,
+    size_t const *inputs, double const *tables, double const *inter,
+    inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
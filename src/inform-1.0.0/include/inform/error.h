@@ -38,6 +38,7 @@ typedef enum
     INFORM_ETPMROW      = 17, /// all zero row in transition probability matrix
     INFORM_ESIZE        = 18, /// invalid size,
     INFORM_EPARTS       = 19, /// invalid partitioning
+    INFORM_ECOV         = 20, /// covariance matrix is not positive definite
 } inform_error;
 
 /// set an error as pointed to by ERR
@@ -0,0 +1,87 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Compute the mutual information between continuously-valued time series
+ * under the assumption that they are jointly Gaussian.
+ *
+ * The covariance matrix is accumulated in a single pass over the data and
+ * the mutual information is evaluated from log-determinants obtained by
+ * Cholesky factorisation.
+ *
+ * @param[in] series the time series
+ * @param[in] l      the number of time series
+ * @param[in] n      the number of elements per time series
+ * @param[out] err   an error code
+ * @return the mutual information between the time series
+ */
+EXPORT double inform_gaussian_mutual_info(double const *series, size_t l,
+    size_t n, inform_error *err);
+
+/**
+ * Compute the conditional (differential) entropy of one continuously-valued
+ * time series given another under the assumption that they are jointly
+ * Gaussian, using the first as the condition.
+ *
+ * @param[in] xs   the condition time series
+ * @param[in] ys   the target time series
+ * @param[in] n    the number of elements per time series
+ * @param[out] err an error code
+ * @return the conditional entropy in bits
+ */
+EXPORT double inform_gaussian_conditional_entropy(double const *xs,
+    double const *ys, size_t n, inform_error *err);
+
+/**
+ * Compute the transfer entropy from one continuously-valued time series to
+ * another under the assumption that they are jointly Gaussian (linear-Gaussian
+ * or Granger transfer entropy).
+ *
+ * @param[in] src  the ensemble of the source node
+ * @param[in] dst  the ensemble of the destination node
+ * @param[in] back the collection of background nodes
+ * @param[in] l    the number of background nodes
+ * @param[in] n    the number initial conditions
+ * @param[in] m    the number of time steps in each time series
+ * @param[in] k    the history length used to calculate the transfer entropy
+ * @param[out] err an error structure
+ * @return the transfer entropy of the ensemble
+ */
+EXPORT double inform_gaussian_transfer_entropy(double const *src,
+    double const *dst, double const *back, size_t l, size_t n, size_t m,
+    size_t k, inform_error *err);
+
+/**
+ * Compute the linear-Gaussian transfer entropy between every ordered pair of
+ * a collection of continuously-valued time series.
+ *
+ * The lagged covariance of all of the series is accumulated once, and the
+ * Cholesky factor of each destination's history is shared by all of its
+ * sources. The element `te[i + l*j]` is the transfer entropy from series `i`
+ * to series `j`; the diagonal is zero.
+ *
+ * @param[in] series the time series, each of `n` initial conditions and `m`
+ *                   time steps
+ * @param[in] l      the number of time series
+ * @param[in] n      the number initial conditions
+ * @param[in] m      the number of time steps in each time series
+ * @param[in] k      the history length used to calculate the transfer entropy
+ * @param[out] te    an `l x l` array to store the transfer entropies
+ * @param[out] err   an error structure
+ * @return a pointer to the transfer entropy array
+ */
+EXPORT double *inform_gaussian_transfer_entropy_matrix(double const *series,
+    size_t l, size_t n, size_t m, size_t k, double *te, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
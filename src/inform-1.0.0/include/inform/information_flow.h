@@ -29,6 +29,45 @@ EXPORT double inform_information_flow(int const *src, int const *dst,
     int const *back, size_t l_src, size_t l_dst, size_t l_back, size_t n,
     size_t m, int b, inform_error *err);
 
+/**
+ * Compute the information flow between each of a collection of groups of
+ * source variables and each of a collection of groups of destination
+ * variables, all given the same background.
+ *
+ * The variables of `series` are numbered `0` to `l - 1` and laid out as the
+ * sources of `inform_information_flow`. The source groups are listed one
+ * after another in `srcs`, the `i`-th of which has `src_sizes[i]` variables,
+ * and likewise for the destination groups.
+ *
+ * The background and each group are encoded once, and the background
+ * histogram is accumulated once and shared by every pair. The pairs are then
+ * swept in parallel when OpenMP is available.
+ *
+ * @param[in] series    the ensemble of the variables
+ * @param[in] l         the number of variables
+ * @param[in] srcs      the variables of each source group
+ * @param[in] src_sizes the number of variables in each source group
+ * @param[in] nsrc      the number of source groups
+ * @param[in] dsts      the variables of each destination group
+ * @param[in] dst_sizes the number of variables in each destination group
+ * @param[in] ndst      the number of destination groups
+ * @param[in] back      the collection of background nodes
+ * @param[in] l_back    the number of background nodes
+ * @param[in] n         the number initial conditions
+ * @param[in] m         the number of time steps in each time series
+ * @param[in] b         the base or number of distinct states at each time step
+ * @param[out] flows    the `nsrc x ndst` row-major matrix of flows (allocated
+ *                      if NULL)
+ * @param[out] err      an error structure
+ * @return the information flow from each source group to each destination
+ *         group
+ */
+EXPORT double *inform_information_flow_matrix(int const *series, size_t l,
+    size_t const *srcs, size_t const *src_sizes, size_t nsrc,
+    size_t const *dsts, size_t const *dst_sizes, size_t ndst,
+    int const *back, size_t l_back, size_t n, size_t m, int b, double *flows,
+    inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,12 +4,44 @@
 #pragma once
 
 #include <inform/error.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/**
+ * The strategies for searching the partitionings of a system for the extreme
+ * evidence of integration.
+ */
+typedef enum
+{
+    /// every partitioning
+    INFORM_INTEGRATION_EXHAUSTIVE = 0,
+    /// every partitioning into two blocks
+    INFORM_INTEGRATION_BIPARTITION = 1,
+    /// the partitionings visited by simulated annealing
+    INFORM_INTEGRATION_ANNEALED = 2,
+    /// every partitioning, pruned by branch-and-bound
+    INFORM_INTEGRATION_BOUNDED = 3,
+} inform_integration_mode;
+
+/**
+ * The parameters of a search over partitionings.
+ */
+typedef struct inform_integration_search
+{
+    /// the search strategy
+    inform_integration_mode mode;
+    /// the number of moves proposed in each annealing run
+    size_t iterations;
+    /// the time budget in seconds (unlimited if not positive)
+    double seconds;
+    /// the seed of the annealing random number generator
+    uint64_t seed;
+} inform_integration_search;
+
 /**
  * Compute the minimum and maximum evidence of integration for a collection of
  * time series.
@@ -17,6 +49,15 @@ extern "C"
  * The first and second halves of the returned array contain the minimum and
  * maximum evidence, respectively.
  *
+ * The same subsets of variables recur as parts of many partitionings, so the
+ * encoding and local entropy of each subset is computed once and memoised
+ * (keyed by the bitmask of the subset); the evidence for each partitioning is
+ * then a sum of cached entropies. Systems of more than 20 variables, or whose
+ * memo would exceed 1 GiB (`2^l * n` encodings and entropies), fall back to
+ * `inform_integration_evidence_part`. The partitionings are split into
+ * contiguous shards (see `inform_unrank_partitioning`) which are evaluated in
+ * parallel when OpenMP is available. At most 25 variables are supported.
+ *
  * @param[in] series    the time series
  * @param[in] l         the number of time series
  * @param[in] n         the number of time steps per time series
@@ -28,6 +69,62 @@ extern "C"
 EXPORT double *inform_integration_evidence(int const *series, size_t l,
     size_t n, int const *b, double *evidence, inform_error *err);
 
+/**
+ * Compute the minimum and maximum evidence of integration for a collection of
+ * time series over the partitionings with ranks in `[first, first + count)`.
+ *
+ * The ranks are those of `inform_rank_partitioning`. The trivial partitioning
+ * (rank 0) is skipped, so that the evidence over the ranks `[1, Bell(l))` is
+ * that of `inform_integration_evidence`. The extremes over several ranges may
+ * be combined by taking their minimum and maximum, so the partitionings of a
+ * large system can be processed in chunks.
+ *
+ * @param[in] series    the time series
+ * @param[in] l         the number of time series
+ * @param[in] n         the number of time steps per time series
+ * @param[in] b         the bases of the time series
+ * @param[in] first     the rank of the first partitioning
+ * @param[in] count     the number of partitionings
+ * @param[out] evidence the computed evidence of integration
+ * @param[out] err      an error code
+ * @return the minimum and maximum evidience of integration
+ */
+EXPORT double *inform_integration_evidence_range(int const *series, size_t l,
+    size_t n, int const *b, uint64_t first, uint64_t count, double *evidence,
+    inform_error *err);
+
+/**
+ * Compute the minimum and maximum evidence of integration for a collection of
+ * time series over the partitionings visited by a search.
+ *
+ * - `INFORM_INTEGRATION_EXHAUSTIVE` is `inform_integration_evidence`.
+ * - `INFORM_INTEGRATION_BIPARTITION` visits the `2^(l-1) - 1` partitionings
+ *   into two blocks.
+ * - `INFORM_INTEGRATION_ANNEALED` runs simulated annealing twice, for the
+ *   partitionings of least and of greatest mean evidence, and reports the
+ *   extremes over every partitioning proposed.
+ * - `INFORM_INTEGRATION_BOUNDED` gives the same result as the exhaustive
+ *   search, but skips the branches of partitionings which cannot improve
+ *   either extreme at any observation, bounding the evidence through the
+ *   monotonicity of local entropies.
+ *
+ * Except for the exhaustive search, up to 64 variables are supported. The
+ * search stops early if its time budget runs out, in which case the extremes
+ * are those of the partitionings visited so far.
+ *
+ * @param[in] series    the time series
+ * @param[in] l         the number of time series
+ * @param[in] n         the number of time steps per time series
+ * @param[in] b         the bases of the time series
+ * @param[in] search    the search parameters (exhaustive if NULL)
+ * @param[out] evidence the computed evidence of integration
+ * @param[out] err      an error code
+ * @return the minimum and maximum evidience of integration
+ */
+EXPORT double *inform_integration_evidence_search(int const *series,
+    size_t l, size_t n, int const *b, inform_integration_search const *search,
+    double *evidence, inform_error *err);
+
 /**
  * Compute the minimum and maximum evidence of integration for a collection of
  * time series for a given partitioning.
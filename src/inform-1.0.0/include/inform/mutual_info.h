@@ -37,6 +37,88 @@ EXPORT double inform_mutual_info(int const *series, size_t l, size_t n,
 EXPORT double *inform_local_mutual_info(int const *series, size_t l, size_t n,
     int const *b, double *mi, inform_error *err);
 
+/**
+ * Compute the mutual information between every pair of time series,
+ * optionally conditioned on a further set of time series.
+ *
+ * The result is the symmetric `l x l` matrix with `mi[i * l + j]` the mutual
+ * information between series `i` and `j` given the conditions, and the
+ * (conditional) entropy of series `i` on the diagonal. The conditions are
+ * encoded once and the entropy of each series with them is computed once and
+ * shared by all of its pairs, which are visited in cache-sized tiles and in
+ * parallel when OpenMP is available. If `l_cond` is zero the mutual
+ * information is unconditional and `cond` and `b_cond` may be NULL.
+ *
+ * @param[in] series the time series
+ * @param[in] l      the number of time series
+ * @param[in] n      the number of elements per time series
+ * @param[in] b      the base of each time series
+ * @param[in] cond   the conditioning time series
+ * @param[in] l_cond the number of conditioning time series
+ * @param[in] b_cond the base of each conditioning time series
+ * @param[out] mi    the mutual information matrix (allocated if NULL)
+ * @param[in] err    an error code
+ * @return a pointer to the mutual information matrix
+ */
+EXPORT double *inform_mutual_info_matrix(int const *series, size_t l,
+    size_t n, int const *b, int const *cond, size_t l_cond,
+    int const *b_cond, double *mi, inform_error *err);
+
+/**
+ * Compute the time-lagged mutual information I(X_t; Y_{t + tau}) between two
+ * time series (or a series and itself) for every lag tau from 0 to
+ * `max_lag`, pooling the observations across the initial conditions.
+ *
+ * The value at lag `tau` is the mutual information between the first
+ * `m - tau` states of `xs` and the last `m - tau` states of `ys` in each
+ * initial condition, exactly as if the shifted copies were passed to
+ * `inform_mutual_info`. The joint histograms of all of the lags are built in
+ * a single scan of the unshifted series, pairing each state of `xs` with the
+ * states of `ys` at every lag; the scan is split into blocks of observations
+ * (with per-thread histograms) and the lags are then evaluated in parallel
+ * when OpenMP is available. More than `2^31` histogram entries in all
+ * (`(max_lag + 1) * bx * by`) are rejected with `INFORM_ENOMEM`.
+ *
+ * @param[in] xs      the earlier time series
+ * @param[in] ys      the later time series (may be `xs`)
+ * @param[in] n       the number of initial conditions
+ * @param[in] m       the number of time steps in each time series
+ * @param[in] bx      the base of `xs`
+ * @param[in] by      the base of `ys`
+ * @param[in] max_lag the largest lag
+ * @param[out] mi     the mutual information at each lag (allocated if NULL)
+ * @param[in] err     an error code
+ * @return a pointer to the mutual information at each lag
+ */
+EXPORT double *inform_lagged_mutual_info(int const *xs, int const *ys,
+    size_t n, size_t m, int bx, int by, size_t max_lag, double *mi,
+    inform_error *err);
+
+/**
+ * Compute the mutual information between time series at each time step,
+ * estimated across the initial conditions rather than over time.
+ *
+ * Each of the `l` series is an ensemble of `n` initial conditions of `m` time
+ * steps, stored one after another as for `inform_active_info`. The value at
+ * `mi[t]` is the mutual information between the states of the series at time
+ * `t`, with the distributions taken over the initial conditions. The series
+ * are read in place, the histograms of each thread are reused from one time
+ * step to the next, and the time steps are processed in parallel when OpenMP
+ * is available.
+ *
+ * @param[in] series the time series
+ * @param[in] l      the number of time series
+ * @param[in] n      the number of initial conditions
+ * @param[in] m      the number of time steps in each time series
+ * @param[in] b      the base of each time series
+ * @param[out] mi    the mutual information at each time step (allocated if
+ *                   NULL)
+ * @param[in] err    an error code
+ * @return a pointer to the mutual information at each time step
+ */
+EXPORT double *inform_mutual_info_ensemble(int const *series, size_t l,
+    size_t n, size_t m, int const *b, double *mi, inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
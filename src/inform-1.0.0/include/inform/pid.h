@@ -10,26 +10,73 @@ extern "C"
 {
 #endif
 
-typedef struct inform_pid_source
-{
-    size_t *name;
-    struct inform_pid_source **above;
-    struct inform_pid_source **below;
-    size_t size, n_above, n_below;
-    double imin;
-    double pi;
-} inform_pid_source;
-
+/**
+ * The redundancy lattice of a partial information decomposition.
+ *
+ * Each node is an antichain of subsets of the sources, and each subset is a
+ * bitmask of the sources (bit `i` is set if source `i` is a member). The nodes
+ * are in topological order, from the bottom (each source on its own) to the
+ * top (all of the sources together). The antichains and the covering
+ * relations are stored as flat index arrays which are built once for each
+ * number of sources and shared by every lattice; only the `imin` and `pi`
+ * arrays belong to a particular decomposition.
+ */
 typedef struct inform_pid_lattice
 {
-    inform_pid_source **sources;
-    inform_pid_source *top;
-    inform_pid_source *bottom;
+    /// the number of sources
+    size_t l;
+    /// the number of nodes
     size_t size;
+    /// the subsets of node `i` are `names[name_offsets[i]]` up to (but not
+    /// including) `names[name_offsets[i + 1]]`
+    size_t const *names;
+    size_t const *name_offsets;
+    /// the nodes covered by each node, indexed through `below_offsets`
+    size_t const *below;
+    size_t const *below_offsets;
+    /// the nodes covering each node, indexed through `above_offsets`
+    size_t const *above;
+    size_t const *above_offsets;
+    /// the indices of the bottom and top nodes
+    size_t bottom, top;
+    /// the minimum specific information of each node
+    double *imin;
+    /// the partial information of each node
+    double *pi;
 } inform_pid_lattice;
 
+/**
+ * Allocate the redundancy lattice over `l` sources, with the minimum specific
+ * and partial information of each node set to zero.
+ *
+ * @param[in] l    the number of sources (at most 5)
+ * @param[out] err an error code
+ * @return the lattice
+ */
+EXPORT inform_pid_lattice *inform_pid_lattice_alloc(size_t l,
+    inform_error *err);
+
+/**
+ * Free a lattice returned by `inform_pid` or `inform_pid_lattice_alloc`.
+ *
+ * @param[in] l the lattice
+ */
 EXPORT void inform_pid_lattice_free(inform_pid_lattice *l);
 
+/**
+ * Compute the Williams-Beer partial information decomposition of the mutual
+ * information between a stimulus and up to five responses.
+ *
+ * @param[in] stimulus  the stimulus time series
+ * @param[in] responses the response time series
+ * @param[in] l         the number of responses (at most 5)
+ * @param[in] n         the number of time steps in each series
+ * @param[in] bs        the base of the stimulus
+ * @param[in] br        the bases of the responses
+ * @param[out] err      an error code
+ * @return the redundancy lattice with the minimum specific and partial
+ *         information of each node
+ */
 EXPORT inform_pid_lattice *inform_pid(int const *stimulus, int const *responses, size_t l,
         size_t n, int bs, int const *br, inform_error *err);
 
@@ -13,6 +13,10 @@ extern "C"
 /**
  * Compute the separable information into a node from a set of sources
  *
+ * The destination's histories are encoded and counted once and shared by the
+ * active information and the transfer entropy from every source, and the
+ * sources are processed in parallel when OpenMP is available.
+ *
  * @param[in] srcs the ensemble of the source nodes
  * @param[in] dest the ensemble of the target node
  * @param[in] l    the number of source nodes
@@ -29,6 +33,11 @@ EXPORT double inform_separable_info(int const *srcs, int const *dest, size_t l,
 /**
  * Compute the local separable information into a node from a set of sources
  *
+ * As with `inform_separable_info`, the destination is encoded once. The local
+ * values are looked up from tables of the local active information and
+ * transfer entropy of each observed state rather than recomputed for each
+ * observation.
+ *
  * @param[in] srcs the ensemble of the source node
  * @param[in] dest the ensemble of the target node
  * @param[in] l    the number of source nodes
@@ -0,0 +1,110 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * The rules for finding the neighbours of the cells at the edges of a
+ * lattice.
+ */
+typedef enum
+{
+    /// the lattice wraps around at its edges
+    INFORM_BOUNDARY_PERIODIC = 0,
+    /// every cell beyond the edges of the lattice is always in state 0
+    INFORM_BOUNDARY_FIXED = 1,
+} inform_boundary;
+
+/**
+ * A regular one- or two-dimensional lattice of cells, e.g. of a cellular
+ * automaton.
+ *
+ * The time series of the cells are stored one after another, with the first
+ * coordinate varying fastest, so that the series of the cell `(x, y)` starts
+ * at `series + (x + shape[0] * y) * m`.
+ */
+typedef struct inform_lattice
+{
+    /// the number of spatial dimensions (1 or 2)
+    size_t dims;
+    /// the number of cells along each dimension
+    size_t shape[2];
+    /// the boundary rule
+    inform_boundary boundary;
+} inform_lattice;
+
+/**
+ * Compute the local active information of every cell of a lattice whose
+ * cells all follow the same rule.
+ *
+ * The histograms are pooled across the cells, and the local values of cell
+ * `c` are stored at `ai + c * (m - k)`.
+ *
+ * @param[in] series  the time series of the cells
+ * @param[in] lattice the lattice
+ * @param[in] m       the number of time steps in each time series
+ * @param[in] b       the base or number of distinct states at each time step
+ * @param[in] k       the history length
+ * @param[out] ai     the local active information (allocated if NULL)
+ * @param[out] err    an error structure
+ * @return a pointer to the local active information array
+ */
+EXPORT double *inform_lattice_local_active_info(int const *series,
+    inform_lattice const *lattice, size_t m, int b, size_t k, double *ai,
+    inform_error *err);
+
+/**
+ * Compute the local transfer entropy into every cell of a lattice from its
+ * neighbour at a fixed offset, pooling the histograms across the cells.
+ *
+ * The neighbour of the cell at `x` is the cell at `x + offset`, where
+ * `offset` has one entry per dimension. Neighbours are read in place rather
+ * than copied out of the series.
+ *
+ * @param[in] series  the time series of the cells
+ * @param[in] lattice the lattice
+ * @param[in] offset  the offset of the source from each destination cell
+ * @param[in] m       the number of time steps in each time series
+ * @param[in] b       the base or number of distinct states at each time step
+ * @param[in] k       the history length
+ * @param[out] te     the local transfer entropy (allocated if NULL)
+ * @param[out] err    an error structure
+ * @return a pointer to the local transfer entropy array
+ */
+EXPORT double *inform_lattice_local_transfer_entropy(int const *series,
+    inform_lattice const *lattice, int const *offset, size_t m, int b,
+    size_t k, double *te, inform_error *err);
+
+/**
+ * Compute the local separable information of every cell of a lattice given
+ * its neighbours at `noffsets` offsets, listed one after another in
+ * `offsets`, pooling the histograms across the cells.
+ *
+ * The histories of the cells are encoded once and shared by the active
+ * information and the transfer entropy from each neighbour.
+ *
+ * @param[in] series   the time series of the cells
+ * @param[in] lattice  the lattice
+ * @param[in] offsets  the offsets of the sources from each destination cell
+ * @param[in] noffsets the number of offsets
+ * @param[in] m        the number of time steps in each time series
+ * @param[in] b        the base or number of distinct states at each time step
+ * @param[in] k        the history length
+ * @param[out] si      the local separable information (allocated if NULL)
+ * @param[out] err     an error structure
+ * @return a pointer to the local separable information array
+ */
+EXPORT double *inform_lattice_local_separable_info(int const *series,
+    inform_lattice const *lattice, int const *offsets, size_t noffsets,
+    size_t m, int b, size_t k, double *si, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
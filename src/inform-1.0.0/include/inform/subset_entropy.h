@@ -0,0 +1,44 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Compute the joint entropy of every subset of a collection of variables.
+ *
+ * The entropy of the subset of variables whose indices are the set bits of
+ * `mask` is stored at `h[mask]`, so that `h` has `2^l` entries and `h[0]` is
+ * zero. Measures which combine the entropies of many subsets of the same
+ * variables, such as the conditional mutual information, the
+ * multi-information or the interaction information, then reduce to lookups
+ * into the table.
+ *
+ * The joint histogram of all `l` variables is accumulated once, densely if
+ * its support is no larger than the number of observations (or small) and as
+ * a sorted list of the observed states otherwise. Every other histogram is
+ * marginalised from that of a subset with one more variable, visiting the
+ * subsets depth-first so that each histogram is summed over only once. The
+ * subsets are split into independent groups processed in parallel when
+ * OpenMP is available.
+ *
+ * @param[in] series the time series with one variable after another
+ * @param[in] l      the number of variables (at most 30)
+ * @param[in] n      the number of observations of each variable
+ * @param[in] b      the base of each variable
+ * @param[out] h     the entropy of each subset (allocated if NULL)
+ * @param[out] err   an error structure
+ * @return a pointer to the subset entropies
+ */
+EXPORT double *inform_subset_entropy(int const *series, size_t l, size_t n,
+    int const *b, double *h, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
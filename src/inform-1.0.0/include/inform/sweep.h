@@ -0,0 +1,63 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Compute the active information of an ensemble of continuously-valued time
+ * series binned into each of `nb` different numbers of uniform bins.
+ *
+ * The series are scanned once. A joint histogram is accumulated only for the
+ * resolutions which do not divide a finer requested resolution; every other
+ * resolution is derived from the histogram of a finer one by merging
+ * adjacent bins, since uniform bins nest whenever one count divides another.
+ *
+ * @param[in] series the ensemble of time series
+ * @param[in] n      the number of initial conditions
+ * @param[in] m      the number of time steps in each time series
+ * @param[in] bs     the numbers of uniform bins
+ * @param[in] nb     the number of resolutions
+ * @param[in] k      the history length used to calculate the active information
+ * @param[out] ai    the active information at each resolution (allocated if
+ *                   NULL)
+ * @param[out] err   an error structure
+ * @return a pointer to the active information array
+ */
+EXPORT double *inform_active_info_sweep(double const *series, size_t n,
+    size_t m, int const *bs, size_t nb, size_t k, double *ai,
+    inform_error *err);
+
+/**
+ * Compute the transfer entropy from one continuously-valued time series to
+ * another with both binned into each of `nb` different numbers of uniform
+ * bins.
+ *
+ * As with `inform_active_info_sweep`, the series are scanned once and nested
+ * resolutions are derived by merging the bins of a finer one. Each series is
+ * binned according to its own range.
+ *
+ * @param[in] src  the ensemble of the source node
+ * @param[in] dst  the ensemble of the destination node
+ * @param[in] n    the number initial conditions
+ * @param[in] m    the number of time steps in each time series
+ * @param[in] bs   the numbers of uniform bins
+ * @param[in] nb   the number of resolutions
+ * @param[in] k    the history length used to calculate the transfer entropy
+ * @param[out] te  the transfer entropy at each resolution (allocated if NULL)
+ * @param[out] err an error structure
+ * @return a pointer to the transfer entropy array
+ */
+EXPORT double *inform_transfer_entropy_sweep(double const *src,
+    double const *dst, size_t n, size_t m, int const *bs, size_t nb, size_t k,
+    double *te, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
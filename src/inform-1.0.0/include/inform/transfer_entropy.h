@@ -4,6 +4,7 @@
 #pragma once
 
 #include <inform/error.h>
+#include <inform/utilities/binning.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -47,6 +48,56 @@ EXPORT double *inform_local_transfer_entropy(int const *src, int const *dst,
     int const *back, size_t l, size_t n, size_t m, int b, size_t k, double *te,
     inform_error *err);
 
+/**
+ * Compute the transfer entropy from one continuously-valued time series to
+ * another, binning each value as it is observed.
+ *
+ * The binning specification is fit separately to the source, the destination
+ * and each of the background nodes (see `inform_binning_fit`), and no binned
+ * copy of any of them is made.
+ *
+ * @param[in] src  the ensemble of the source node
+ * @param[in] dst  the ensemble of the destination node
+ * @param[in] back the collection of background nodes
+ * @param[in] l    the number of background nodes
+ * @param[in] n    the number initial conditions
+ * @param[in] m    the number of time steps in each time series
+ * @param[in] spec the binning specification
+ * @param[in] k    the history length used to calculate the transfer entropy
+ * @param[out] err an error structure
+ * @return the transfer entropy of the ensemble
+ */
+EXPORT double inform_transfer_entropy_binned(double const *src,
+    double const *dst, double const *back, size_t l, size_t n, size_t m,
+    inform_binning const *spec, size_t k, inform_error *err);
+
+/**
+ * Compute the transfer entropy from one time series to another at each time
+ * step, estimated across the initial conditions rather than over time.
+ *
+ * The value at `te[t - k]` is the transfer entropy into the state of the
+ * destination at time `t`, for `t` from `k` to `m - 1`, with the histograms
+ * accumulated over the `n` initial conditions only. The series are read in
+ * their usual layout, the histograms of each thread are reused from one time
+ * step to the next, and the time steps are processed in parallel when OpenMP
+ * is available.
+ *
+ * @param[in] src  the ensemble of the source node
+ * @param[in] dst  the ensemble of the destination node
+ * @param[in] back the collection of background nodes
+ * @param[in] l    the number of background nodes
+ * @param[in] n    the number initial conditions
+ * @param[in] m    the number of time steps in each time series
+ * @param[in] b    the base or number of distinct states at each time step
+ * @param[in] k    the history length used to calculate the transfer entropy
+ * @param[out] te  the transfer entropy at each time step (allocated if NULL)
+ * @param[out] err an error structure
+ * @return a pointer to the transfer entropy at each time step
+ */
+EXPORT double *inform_transfer_entropy_ensemble(int const *src,
+    int const *dst, int const *back, size_t l, size_t n, size_t m, int b,
+    size_t k, double *te, inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
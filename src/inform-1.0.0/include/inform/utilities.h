@@ -6,9 +6,11 @@
 #include <inform/utilities/binning.h>
 #include <inform/utilities/black_boxing.h>
 #include <inform/utilities/coalesce.h>
+#include <inform/utilities/counting.h>
 #include <inform/utilities/encoding.h>
 #include <inform/utilities/partitions.h>
 #include <inform/utilities/random.h>
+#include <inform/utilities/sketch.h>
 #include <inform/utilities/tpm.h>
 
 #ifndef MIN
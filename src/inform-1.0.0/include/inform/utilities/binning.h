@@ -10,6 +10,89 @@ extern "C"
 {
 #endif
 
+/**
+ * The methods by which a continuously-valued timeseries can be binned.
+ */
+typedef enum
+{
+    INFORM_BIN_UNIFORM = 0, /// `b` uniform bins spanning the range
+    INFORM_BIN_STEP    = 1, /// bins of size `step` starting at the minimum
+    INFORM_BIN_BOUNDS  = 2, /// bins with specified (e.g. quantile) boundaries
+} inform_bin_method;
+
+/**
+ * A specification of how to bin a continuously-valued timeseries, so that
+ * estimators can discretise values as they are observed rather than
+ * requiring an intermediate binned timeseries.
+ *
+ * The user sets `method` and the corresponding `b`, `step` or `bounds` and
+ * `m`; the remaining fields are filled in by `inform_binning_fit`, which
+ * rejects non-finite values so that every value binned by
+ * `inform_binning_apply` falls in one of the `b` bins.
+ */
+typedef struct inform_binning
+{
+    /// the binning method
+    inform_bin_method method;
+    /// the number of bins (uniform bins, or filled in by the fit)
+    int b;
+    /// the size of each bin
+    double step;
+    /// the ascending bin boundaries
+    double const *bounds;
+    /// the number of bin boundaries
+    size_t m;
+    /// the minimum value of the fitted timeseries
+    double min;
+    /// the maximum value of the fitted timeseries
+    double max;
+} inform_binning;
+
+/**
+ * Fit a binning specification to a continuously-valued timeseries, i.e.
+ * compute its range if the method requires it and the number of bins. A
+ * timeseries with a non-finite value is rejected with `INFORM_EBIN`.
+ *
+ * @param[in,out] spec the binning specification
+ * @param[in] series   the timeseries
+ * @param[in] n        the length of the timeseries
+ * @param[out] err     the error code
+ * @return the number of bins
+ */
+EXPORT int inform_binning_fit(inform_binning *spec, double const *series,
+    size_t n, inform_error *err);
+
+/**
+ * Bin a single value according to a fitted binning specification, exactly as
+ * `inform_bin`, `inform_bin_step` or `inform_bin_bounds` would.
+ *
+ * @param[in] spec the fitted binning specification
+ * @param[in] x    the value
+ * @return the bin of the value
+ */
+static inline int inform_binning_apply(inform_binning const *spec, double x)
+{
+    if (spec->method == INFORM_BIN_BOUNDS)
+    {
+        double const *base = spec->bounds;
+        size_t m = spec->m;
+        while (m > 1)
+        {
+            size_t half = m / 2;
+            base = (base[half] <= x) ? base + half : base;
+            m -= half;
+        }
+        return (int) (base - spec->bounds) + (*base <= x);
+    }
+    int bin = (int) ((x - spec->min) / spec->step);
+    if (spec->method == INFORM_BIN_UNIFORM)
+    {
+        bin -= (x == spec->max);
+    }
+    // rounding can place a value just below the maximum one past the last bin
+    return (bin < 0) ? 0 : ((bin < spec->b) ? bin : spec->b - 1);
+}
+
 /**
  * Compute the range of a continuously-valued timeseries.
  *
@@ -52,6 +135,9 @@ EXPORT int inform_bin_step(double const *series, size_t n, double step,
 /**
  * Bin a continuously-valued timeseries into bins with specified boundaries.
  *
+ * The boundaries must be sorted in ascending order; each value is located by
+ * a branchless binary search over the boundaries.
+ *
  * @param[in] series  the timeseries
  * @param[in] n       the length of the timeseries
  * @param[in] bounds  desired bin boundaries
@@ -63,6 +149,92 @@ EXPORT int inform_bin_step(double const *series, size_t n, double step,
 EXPORT int inform_bin_bounds(double const *series, size_t n,
     double const *bounds, size_t m, int *binned, inform_error *err);
 
+/**
+ * Bin each of the `c` columns of a continuously-valued matrix into `b` uniform
+ * bins in a single call. The range of each column is computed independently
+ * and the columns are processed in parallel when OpenMP is available.
+ *
+ * @param[in] series  the matrix of timeseries, stored column-by-column
+ * @param[in] n       the length of each column
+ * @param[in] c       the number of columns
+ * @param[in] b       the desired number of bins
+ * @param[out] binned the resulting binned columns (allocated if NULL)
+ * @param[out] steps  the size of the bins of each column (may be NULL)
+ * @param[out] err    the error code
+ * @return a pointer to the binned columns
+ */
+EXPORT int *inform_bin_columns(double const *series, size_t n, size_t c,
+    int b, int *binned, double *steps, inform_error *err);
+
+/**
+ * Bin each of the `c` columns of a continuously-valued matrix into bins of
+ * uniform size `step` in a single call.
+ *
+ * @param[in] series  the matrix of timeseries, stored column-by-column
+ * @param[in] n       the length of each column
+ * @param[in] c       the number of columns
+ * @param[in] step    the desired size of each bin
+ * @param[out] binned the resulting binned columns (allocated if NULL)
+ * @param[out] b      the number of bins of each column (may be NULL)
+ * @param[out] err    the error code
+ * @return a pointer to the binned columns
+ */
+EXPORT int *inform_bin_step_columns(double const *series, size_t n, size_t c,
+    double step, int *binned, int *b, inform_error *err);
+
+/**
+ * Bin each of the `c` columns of a continuously-valued matrix into bins with
+ * the specified (ascending) boundaries in a single call.
+ *
+ * @param[in] series  the matrix of timeseries, stored column-by-column
+ * @param[in] n       the length of each column
+ * @param[in] c       the number of columns
+ * @param[in] bounds  desired bin boundaries
+ * @param[in] m       the number of specified bin boundaries
+ * @param[out] binned the resulting binned columns (allocated if NULL)
+ * @param[out] b      the number of bins of each column (may be NULL)
+ * @param[out] err    the error code
+ * @return a pointer to the binned columns
+ */
+EXPORT int *inform_bin_bounds_columns(double const *series, size_t n, size_t c,
+    double const *bounds, size_t m, int *binned, int *b, inform_error *err);
+
+/**
+ * Bin a continuously-valued timeseries into `b` bins of (approximately) equal
+ * frequency.
+ *
+ * The `b - 1` boundaries are the order statistics of rank `floor(i*n/b)`,
+ * found by selection on a copy of the series rather than by sorting it.
+ *
+ * @param[in] series  the timeseries
+ * @param[in] n       the length of the timeseries
+ * @param[in] b       the desired number of bins
+ * @param[out] binned the resulting binned timeseries
+ * @param[out] bounds the `b - 1` bin boundaries (may be NULL)
+ * @param[out] err    the error code
+ * @return the number of bins
+ */
+EXPORT int inform_bin_quantile(double const *series, size_t n, int b,
+    int *binned, double *bounds, inform_error *err);
+
+/**
+ * Bin each of the `c` columns of a continuously-valued matrix into `b` bins
+ * of (approximately) equal frequency in a single call.
+ *
+ * @param[in] series  the matrix of timeseries, stored column-by-column
+ * @param[in] n       the length of each column
+ * @param[in] c       the number of columns
+ * @param[in] b       the desired number of bins
+ * @param[out] binned the resulting binned columns (allocated if NULL)
+ * @param[out] bounds the `b - 1` boundaries of each column (may be NULL)
+ * @param[out] nbins  the number of bins of each column (may be NULL)
+ * @param[out] err    the error code
+ * @return a pointer to the binned columns
+ */
+EXPORT int *inform_bin_quantile_columns(double const *series, size_t n,
+    size_t c, int b, int *binned, double *bounds, int *nbins,
+    inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
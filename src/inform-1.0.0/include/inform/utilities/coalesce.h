@@ -4,6 +4,7 @@
 #pragma once
 
 #include <inform/error.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -13,6 +14,10 @@ extern "C"
 /**
  * Coalesce a timeseries into as few states contiguous states as possible.
  *
+ * The ordering of the states is preserved. A direct lookup table is used if
+ * the range of the series is comparable to its length, and a hash map of the
+ * distinct states otherwise, so that only the distinct states are sorted.
+ *
  * @param[in] series  the timeseries
  * @param[in] n       the length of the timeseries
  * @param[out] coal   the resulting coalesced timeseries
@@ -22,6 +27,52 @@ extern "C"
 EXPORT int inform_coalesce(int const *series, size_t n, int *coal,
     inform_error *err);
 
+/**
+ * Coalesce each of the `c` columns of a matrix of timeseries independently
+ * in a single call. The columns are processed in parallel when OpenMP is
+ * available.
+ *
+ * @param[in] series the timeseries, stored column-by-column
+ * @param[in] n      the length of each column
+ * @param[in] c      the number of columns
+ * @param[out] coal  the coalesced columns (allocated if NULL)
+ * @param[out] b     the number of unique states of each column (may be NULL)
+ * @param[out] err   the error code
+ * @return a pointer to the coalesced columns
+ */
+EXPORT int *inform_coalesce_columns(int const *series, size_t n, size_t c,
+    int *coal, int *b, inform_error *err);
+
+/**
+ * Coalesce the `c` columns of a matrix of timeseries with a single mapping
+ * shared by all of them, so that a state is given the same label in every
+ * column.
+ *
+ * @param[in] series the timeseries, stored column-by-column
+ * @param[in] n      the length of each column
+ * @param[in] c      the number of columns
+ * @param[out] coal  the coalesced columns
+ * @param[out] err   the error code
+ * @return the number of unique states across all of the columns
+ */
+EXPORT int inform_coalesce_joint(int const *series, size_t n, size_t c,
+    int *coal, inform_error *err);
+
+/**
+ * Coalesce a series of 64-bit state codes, such as those produced by
+ * `inform_black_box_codes`, into contiguous states, preserving their order.
+ * The result is a valid time series whose base is the number of unique
+ * states, however large the codes themselves are.
+ *
+ * @param[in] series the codes
+ * @param[in] n      the number of codes
+ * @param[out] coal  the resulting coalesced timeseries
+ * @param[out] err   the error code
+ * @return the number of unique states
+ */
+EXPORT int inform_coalesce_codes(uint64_t const *series, size_t n, int *coal,
+    inform_error *err);
+
 #ifdef __cplusplus
 }
 #endif
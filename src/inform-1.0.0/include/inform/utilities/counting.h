@@ -0,0 +1,71 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Count the distinct states in a series of 64-bit state codes, such as the
+ * joint states of many variables or those produced by
+ * `inform_black_box_codes`, without a histogram over every possible state.
+ *
+ * The codes are radix sorted, one byte per pass and only over the bytes that
+ * the largest code occupies, and the runs of equal codes are counted, so the
+ * time and memory are linear in the number of codes however large the codes
+ * themselves are. The distinct states are written in increasing order to
+ * `states` and their counts to `counts`, and the count of the state of each
+ * code is written to `local`. Any of the outputs may be NULL.
+ *
+ * @param[in] codes   the state codes
+ * @param[in] n       the number of codes
+ * @param[out] states the distinct states (at most `n`)
+ * @param[out] counts the number of occurrences of each distinct state
+ * @param[out] local  the number of occurrences of the state of each code
+ * @param[out] err    an error code
+ * @return the number of distinct states
+ */
+EXPORT size_t inform_count_codes(uint64_t const *codes, size_t n,
+    uint64_t *states, uint32_t *counts, uint32_t *local, inform_error *err);
+
+/**
+ * Count the distinct states in a series of 64-bit state codes as
+ * `inform_count_codes` does, but sort them in scratch space supplied by the
+ * caller, so that repeated counts need not allocate.
+ *
+ * @param[in] codes   the state codes
+ * @param[in] n       the number of codes
+ * @param[out] states the distinct states (at most `n`)
+ * @param[out] counts the number of occurrences of each distinct state
+ * @param[out] local  the number of occurrences of the state of each code
+ * @param[in] keys    scratch space for `2n` codes
+ * @param[in] index   scratch space for `2n` positions (only read if `local`
+ *                    is not NULL)
+ * @param[out] err    an error code
+ * @return the number of distinct states
+ */
+EXPORT size_t inform_count_codes_buffered(uint64_t const *codes, size_t n,
+    uint64_t *states, uint32_t *counts, uint32_t *local, uint64_t *keys,
+    uint32_t *index, inform_error *err);
+
+/**
+ * Compute the Shannon entropy (in bits) of the empirical distribution of a
+ * series of 64-bit state codes by counting the runs of the sorted codes.
+ *
+ * @param[in] codes the state codes
+ * @param[in] n     the number of codes
+ * @param[out] err  an error code
+ * @return the entropy of the codes
+ */
+EXPORT double inform_code_entropy(uint64_t const *codes, size_t n,
+    inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
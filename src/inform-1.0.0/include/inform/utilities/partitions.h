@@ -4,6 +4,7 @@
 #pragma once
 
 #include <inform/export.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -30,6 +31,60 @@ EXPORT size_t *inform_first_partitioning(size_t size);
  */
 EXPORT size_t inform_next_partitioning(size_t *xs, size_t size);
 
+/**
+ * Compute the number of partitionings of a set of a given size (the Bell
+ * number)
+ *
+ * @param[in] size the number of elements
+ * @return the number of partitionings, or 0 if it does not fit in 64 bits
+ *         (`size > 25`)
+ */
+EXPORT uint64_t inform_bell_number(size_t size);
+
+/**
+ * Compute the rank of a partitioning in the order in which
+ * `inform_next_partitioning` enumerates them
+ *
+ * Partitionings are enumerated as restricted growth strings in lexicographic
+ * order, so the first partitioning has rank 0 and the finest has rank
+ * `inform_bell_number(size) - 1`.
+ *
+ * @param[in] xs   the partitioning (a restricted growth string)
+ * @param[in] size the number of elements (at most 25)
+ * @return the rank of the partitioning
+ */
+EXPORT uint64_t inform_rank_partitioning(size_t const *xs, size_t size);
+
+/**
+ * Compute the partitioning of a given rank
+ *
+ * Together with `inform_next_partitioning_blocks`, this allows the
+ * partitionings to be split into contiguous shards which are enumerated
+ * independently.
+ *
+ * @param[in] rank    the rank of the partitioning
+ * @param[in] size    the number of elements (at most 25)
+ * @param[out] xs     the partitioning
+ * @param[out] blocks the number of blocks in each prefix of the partitioning
+ *                    (may be NULL)
+ * @return the number of partitions, or 0 if `rank` is out of range
+ */
+EXPORT size_t inform_unrank_partitioning(uint64_t rank, size_t size,
+    size_t *xs, size_t *blocks);
+
+/**
+ * Compute the next partition in place, maintaining the number of blocks in
+ * each prefix of the partitioning so that the number of partitions is found
+ * without rescanning the partitioning
+ *
+ * @param[in,out] xs     the current partition
+ * @param[in,out] blocks the number of blocks in each prefix of `xs`
+ * @param[in] size       the number of elements
+ * @return the number of partitions, or 0 if `xs` was the last partitioning
+ */
+EXPORT size_t inform_next_partitioning_blocks(size_t *xs, size_t *blocks,
+    size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#pragma once
+
+#include <inform/error.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * A mergeable quantile sketch of a stream of continuous values.
+ *
+ * The sketch is a hierarchy of compactors in the style of Karnin, Lang and
+ * Liberty (KLL). Items retained at level `h` each stand for `2^h`
+ * observations. When a level fills up, it is sorted and every other item is
+ * promoted to the level above, so that the number of retained items is
+ * bounded by `O(k)` regardless of the length of the stream.
+ */
+typedef struct inform_quantile_sketch
+{
+    /// the accuracy parameter (capacity of the top compactor)
+    size_t k;
+    /// the number of observations summarised so far
+    uint64_t counts;
+    /// the number of compactor levels
+    size_t levels;
+    /// the items retained at each level
+    double **items;
+    /// the number of items retained at each level
+    size_t *sizes;
+    /// the allocated capacity of each level
+    size_t *capacities;
+} inform_qsketch;
+
+/**
+ * Allocate an empty quantile sketch with accuracy parameter `k`.
+ *
+ * @param[in] k the accuracy parameter (at least 8)
+ * @return the sketch, or NULL if `k < 8` or allocation failed
+ */
+EXPORT inform_qsketch *inform_qsketch_alloc(size_t k);
+
+/**
+ * Free a quantile sketch.
+ *
+ * @param[in] sketch the sketch to free (may be NULL)
+ */
+EXPORT void inform_qsketch_free(inform_qsketch *sketch);
+
+/**
+ * The maximum number of items a sketch with accuracy parameter `k` retains.
+ *
+ * @param[in] k the accuracy parameter
+ * @return an upper bound on the number of retained items
+ */
+EXPORT size_t inform_qsketch_max_size(size_t k);
+
+/**
+ * The number of items currently retained by a sketch.
+ *
+ * @param[in] sketch the sketch
+ * @return the number of retained items
+ */
+EXPORT size_t inform_qsketch_size(inform_qsketch const *sketch);
+
+/**
+ * Add a single item to a sketch at a given level without compacting.
+ *
+ * This is primarily useful to rebuild a sketch that has been stored as a
+ * flat array of items and levels.
+ *
+ * @param[in,out] sketch the sketch
+ * @param[in] x          the item
+ * @param[in] level      the level of the item
+ * @param[out] err       the error code
+ * @return the sketch
+ */
+EXPORT inform_qsketch *inform_qsketch_insert(inform_qsketch *sketch, double x,
+    size_t level, inform_error *err);
+
+/**
+ * Summarise `n` further observations in a sketch.
+ *
+ * @param[in,out] sketch the sketch
+ * @param[in] series     the observations
+ * @param[in] n          the number of observations
+ * @param[out] err       the error code
+ * @return the sketch
+ */
+EXPORT inform_qsketch *inform_qsketch_update(inform_qsketch *sketch,
+    double const *series, size_t n, inform_error *err);
+
+/**
+ * Merge the sketch `other` into `sketch`. Both sketches must have been
+ * allocated with the same accuracy parameter.
+ *
+ * @param[in,out] sketch the sketch to merge into
+ * @param[in] other      the sketch to merge
+ * @param[out] err       the error code
+ * @return the merged sketch
+ */
+EXPORT inform_qsketch *inform_qsketch_merge(inform_qsketch *sketch,
+    inform_qsketch const *other, inform_error *err);
+
+/**
+ * Estimate the `q`-th quantile of the observations summarised by a sketch.
+ *
+ * @param[in] sketch the sketch
+ * @param[in] q      the quantile, in `[0, 1]`
+ * @param[out] err   the error code
+ * @return the estimated quantile
+ */
+EXPORT double inform_qsketch_quantile(inform_qsketch const *sketch, double q,
+    inform_error *err);
+
+/**
+ * Estimate the `b - 1` boundaries which divide the observations summarised
+ * by a sketch into `b` equiprobable bins. The boundaries can be used
+ * directly with `inform_bin_bounds`.
+ *
+ * @param[in] sketch  the sketch
+ * @param[in] b       the desired number of bins
+ * @param[out] bounds the boundaries (allocated if NULL)
+ * @param[out] err    the error code
+ * @return a pointer to the boundaries
+ */
+EXPORT double *inform_qsketch_bounds(inform_qsketch const *sketch, int b,
+    double *bounds, inform_error *err);
+
+#ifdef __cplusplus
+}
+#endif
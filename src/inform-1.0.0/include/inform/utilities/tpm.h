@@ -4,12 +4,64 @@
 #pragma once
 
 #include <inform/error.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/**
+ * A transition probability matrix stored in compressed sparse row (CSR)
+ * format: the nonzero probabilities of transitioning from state `i` are
+ * `values[offsets[i]]` through `values[offsets[i+1] - 1]`, to the states
+ * given by the same entries of `columns` in increasing order.
+ */
+typedef struct inform_sparse_tpm
+{
+    /// the number of states
+    size_t size;
+    /// the number of nonzero transition probabilities
+    size_t nnz;
+    /// the offsets of each row (`size + 1` entries)
+    size_t *offsets;
+    /// the successor state of each nonzero entry
+    size_t *columns;
+    /// the transition probability of each nonzero entry
+    double *values;
+} inform_sparse_tpm;
+
+/**
+ * The transition probabilities of an order-`k` Markov model: the probability
+ * of each state given the `k` states which precede it. Only the observed
+ * histories are stored, one row each in increasing order of their encodings
+ * (with the earliest state as the most significant digit), and each row holds
+ * the observed successors `futures[offsets[i]]` through
+ * `futures[offsets[i+1] - 1]` in increasing order. The transition counts are
+ * retained, so that further observations can be accumulated.
+ */
+typedef struct inform_history_tpm
+{
+    /// the base of the time series
+    int b;
+    /// the history length
+    size_t k;
+    /// the number of observed histories
+    size_t rows;
+    /// the number of observed transitions (nonzero entries)
+    size_t nnz;
+    /// the encoding of each observed history
+    uint64_t *histories;
+    /// the offsets of each row (`rows + 1` entries)
+    size_t *offsets;
+    /// the successor state of each entry
+    int *futures;
+    /// the number of times each transition was observed
+    uint64_t *counts;
+    /// the transition probability of each entry
+    double *values;
+} inform_history_tpm;
+
 /**
  * Compute the a transition probability matrix from a time series.
  *
@@ -27,6 +79,62 @@ extern "C"
 EXPORT double *inform_tpm(int const *series, size_t n, size_t m, int b,
     double *tpm, inform_error *err);
 
+/**
+ * Compute a sparse transition probability matrix from a time series.
+ *
+ * Unlike `inform_tpm`, the time and memory required are proportional to the
+ * number of observed transitions (and the base), rather than the square of the
+ * base. As with `inform_tpm`, a state which is never followed by another
+ * raises `INFORM_ETPMROW` and is left with an empty row.
+ *
+ * @param[in] series the timeseries
+ * @param[in] n      the number of initial conditions
+ * @param[in] m      the number of time steps for each initial condition
+ * @param[in] b      the base of the time series
+ * @param[out] err   an error code
+ * @return the sparse transition probability matrix
+ */
+EXPORT inform_sparse_tpm *inform_tpm_sparse(int const *series, size_t n,
+    size_t m, int b, inform_error *err);
+
+/**
+ * Free a sparse transition probability matrix.
+ *
+ * @param[in] tpm the matrix to free (may be NULL)
+ */
+EXPORT void inform_sparse_tpm_free(inform_sparse_tpm *tpm);
+
+/**
+ * Compute the order-`k` transition probability matrix of a time series.
+ *
+ * The histories are rolled along each series as in `inform_active_info`, and
+ * only the observed transitions are stored. If `tpm` is not `NULL`, the
+ * transitions are accumulated into it and the probabilities are updated, so
+ * that a long series (or ensemble) can be processed in chunks; the base and
+ * history length must then agree with those of `tpm`. Each chunk is treated
+ * as an independent replicate whose first `k` states only form a history, so
+ * the transitions which cross a chunk boundary are counted only if
+ * consecutive chunks overlap by `k` time steps.
+ *
+ * @param[in] series  the timeseries
+ * @param[in] n       the number of initial conditions
+ * @param[in] m       the number of time steps for each initial condition
+ * @param[in] b       the base of the time series
+ * @param[in] k       the history length
+ * @param[in,out] tpm the transition probability matrix to update (or NULL)
+ * @param[out] err    an error code
+ * @return the transition probability matrix
+ */
+EXPORT inform_history_tpm *inform_tpm_k(int const *series, size_t n, size_t m,
+    int b, size_t k, inform_history_tpm *tpm, inform_error *err);
+
+/**
+ * Free an order-`k` transition probability matrix.
+ *
+ * @param[in] tpm the matrix to free (may be NULL)
+ */
+EXPORT void inform_history_tpm_free(inform_history_tpm *tpm);
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,6 +66,65 @@ static void accumulate_local_observations(int const* series, size_t n, size_t m,
     }
 }
 
+static void accumulate_binned_observations(double const* series, size_t n,
+    size_t m, inform_binning const *spec, int b, size_t k,
+    inform_dist *states, inform_dist *histories, inform_dist *futures)
+{
+    for (size_t i = 0; i < n; ++i, series += m)
+    {
+        int history = 0, q = 1, state, future;
+        for (size_t j = 0; j < k; ++j)
+        {
+            q *= b;
+            history *= b;
+            history += inform_binning_apply(spec, series[j]);
+        }
+        for (size_t j = k; j < m; ++j)
+        {
+            future = inform_binning_apply(spec, series[j]);
+            state  = history * b + future;
+
+            states->histogram[state]++;
+            histories->histogram[history]++;
+            futures->histogram[future]++;
+
+            history = state % q;
+        }
+    }
+}
+
+static double average_active_info(inform_dist const *states,
+    inform_dist const *histories, inform_dist const *futures, int b, size_t N)
+{
+    double ai = 0.0;
+    int state;
+    double n_state, n_history, n_future;
+    for (int history = 0; history < (int) histories->size; ++history)
+    {
+        n_history = histories->histogram[history];
+        if (n_history == 0)
+        {
+            continue;
+        }
+        for (int future = 0; future < b; ++future)
+        {
+            n_future = futures->histogram[future];
+            if (n_future == 0)
+            {
+                continue;
+            }
+            state = history * b + future;
+            n_state = states->histogram[state];
+            if (n_state == 0)
+            {
+                continue;
+            }
+            ai += n_state * log2((N * n_state) / (n_history * n_future));
+        }
+    }
+    return ai / N;
+}
+
 static bool check_arguments(int const *series, size_t n, size_t m, int b,
     size_t k, inform_error *err)
 {
@@ -131,36 +190,11 @@ double inform_active_info(int const *series, size_t n, size_t m, int b,
 
     accumulate_observations(series, n, m, b, k, &states, &histories, &futures);
 
-    double ai = 0.0;
-    int state;
-    double n_state, n_history, n_future;
-    for (int history = 0; history < (int) histories_size; ++history)
-    {
-        n_history = histories.histogram[history];
-        if (n_history == 0)
-        {
-            continue;
-        }
-        for (int future = 0; future < b; ++future)
-        {
-            n_future = futures.histogram[future];
-            if (n_future == 0)
-            {
-                continue;
-            }
-            state = history * b + future;
-            n_state = states.histogram[state];
-            if (n_state == 0)
-            {
-                continue;
-            }
-            ai += n_state * log2((N * n_state) / (n_history * n_future));
-        }
-    }
+    double ai = average_active_info(&states, &histories, &futures, b, N);
 
     free(data);
 
-    return ai / N;
+    return ai;
 }
 
 double *inform_local_active_info(int const *series, size_t n, size_t m, int b,
@@ -223,3 +257,171 @@ double *inform_local_active_info(int const *series, size_t n, size_t m, int b,
 
     return ai;
 }
+
+double inform_active_info_binned(double const *series, size_t n, size_t m,
+    inform_binning const *spec, size_t k, inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NAN);
+    }
+    else if (spec == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NAN);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, NAN);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NAN);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, NAN);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, NAN);
+    }
+
+    inform_binning fitted = *spec;
+    int b = inform_binning_fit(&fitted, series, n * m, err);
+    if (inform_failed(err))
+    {
+        return NAN;
+    }
+    b = (b < 2) ? 2 : b;
+
+    size_t const N = n * (m - k);
+
+    size_t const states_size = (size_t) (b * pow((double) b,(double) k));
+    size_t const histories_size = states_size / b;
+    size_t const futures_size = b;
+    size_t const total_size = states_size + histories_size + futures_size;
+
+    uint32_t *data = calloc(total_size, sizeof(uint32_t));
+    if (data == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+
+    inform_dist states    = { data, states_size, N };
+    inform_dist histories = { data + states_size, histories_size, N };
+    inform_dist futures   = { data + states_size + histories_size, futures_size, N };
+
+    accumulate_binned_observations(series, n, m, &fitted, b, k, &states,
+        &histories, &futures);
+
+    double ai = average_active_info(&states, &histories, &futures, b, N);
+
+    free(data);
+
+    return ai;
+}
+
+// Encode the state (the k-history followed by the next state) of every
+// initial condition at time `t`, reading each time series in place.
+static void encode_ensemble_states(int const *series, size_t n, size_t m,
+    int b, size_t k, size_t t, int *state)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        int const *x = series + i * m + t - k;
+        int s = 0;
+        for (size_t j = 0; j <= k; ++j)
+        {
+            s = s * b + x[j];
+        }
+        state[i] = s;
+    }
+}
+
+// The active information of the `n` states observed at one time step. Only
+// the histogram entries which are touched are read, and they are left zeroed
+// for the next time step.
+static double ensemble_active_info(int const *state, size_t n, int b,
+    uint32_t *states, uint32_t *histories, uint32_t *futures)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        states[state[i]]++;
+        histories[state[i] / b]++;
+        futures[state[i] % b]++;
+    }
+    double ai = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double const n_state = states[state[i]];
+        if (n_state != 0)
+        {
+            double const n_history = histories[state[i] / b];
+            double const n_future = futures[state[i] % b];
+            ai += n_state * log2((n * n_state) / (n_history * n_future));
+            states[state[i]] = 0;
+        }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        histories[state[i] / b] = 0;
+        futures[state[i] % b] = 0;
+    }
+    return ai / n;
+}
+
+double *inform_active_info_ensemble(int const *series, size_t n, size_t m,
+    int b, size_t k, double *ai, inform_error *err)
+{
+    if (check_arguments(series, n, m, b, k, err)) return NULL;
+
+    size_t const w = m - k;
+    size_t const states_size = (size_t) (b * pow((double) b, (double) k));
+    size_t const total_size = states_size + states_size / b + b;
+
+    bool const allocate_ai = (ai == NULL);
+    if (allocate_ai)
+    {
+        ai = malloc(w * sizeof(double));
+    }
+    if (ai == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *data = calloc(total_size, sizeof(uint32_t));
+        int *state = malloc(n * sizeof(int));
+        bool const ready = (data != NULL && state != NULL);
+        if (!ready)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (size_t t = 0; t < w; ++t)
+        {
+            if (!ready) continue;
+            encode_ensemble_states(series, n, m, b, k, t + k, state);
+            ai[t] = ensemble_active_info(state, n, b, data,
+                data + states_size, data + states_size + states_size / b);
+        }
+        free(state);
+        free(data);
+    }
+
+    if (failed)
+    {
+        if (allocate_ai) free(ai);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return ai;
+}
@@ -0,0 +1,662 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/causal_emergence.h>
+#include <inform/utilities.h>
+#include <math.h>
+#include <string.h>
+
+#define EMERGENCE_INITIAL_TEMPERATURE 1.0
+#define EMERGENCE_FINAL_TEMPERATURE 1e-3
+
+// A coarse-graining of the micro-states into macro-states, each of which
+// occupies one of `n` slots (some of which are empty). The unnormalised
+// macro-scale matrix `w[A*n + B]` is the total probability of a transition
+// from a micro-state of A to one of B, so that its rows, divided by the sizes
+// of the macro-states, are the rows of the macro-scale matrix.
+typedef struct macro_state
+{
+    size_t n;
+    double const *tpm;
+    size_t *group;
+    size_t *sizes;
+    double *w;
+    /// the entropy of each row of the macro-scale matrix
+    double *h;
+    /// the sums of the columns of the macro-scale matrix
+    double *col;
+    double *rowagg, *colagg;
+    /// the number of macro-states
+    size_t k;
+    /// the sum of the entropies of the rows
+    double s;
+} macro_state;
+
+inline static double f(double p)
+{
+    return (p > 0.0) ? -p * log2(p) : 0.0;
+}
+
+static bool macro_alloc(macro_state *m, double const *tpm, size_t n)
+{
+    m->n = n;
+    m->tpm = tpm;
+    m->group = malloc(2 * n * sizeof(size_t));
+    m->w = malloc((n * n + 4 * n) * sizeof(double));
+    if (m->group == NULL || m->w == NULL)
+    {
+        free(m->w);
+        free(m->group);
+        return false;
+    }
+    m->sizes = m->group + n;
+    m->h = m->w + n * n;
+    m->col = m->h + n;
+    m->rowagg = m->col + n;
+    m->colagg = m->rowagg + n;
+    return true;
+}
+
+static void macro_free(macro_state *m)
+{
+    free(m->w);
+    free(m->group);
+}
+
+// Aggregate the macro-scale matrix of a coarse-graining from scratch.
+static void macro_init(macro_state *m, size_t const *groups)
+{
+    size_t const n = m->n;
+    memset(m->sizes, 0, n * sizeof(size_t));
+    memset(m->w, 0, n * n * sizeof(double));
+    memset(m->col, 0, n * sizeof(double));
+    for (size_t i = 0; i < n; ++i)
+    {
+        m->group[i] = (groups != NULL) ? groups[i] : i;
+        m->sizes[m->group[i]]++;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        double *row = m->w + m->group[i] * n;
+        for (size_t j = 0; j < n; ++j)
+        {
+            row[m->group[j]] += m->tpm[i * n + j];
+        }
+    }
+
+    m->k = 0;
+    m->s = 0.0;
+    for (size_t a = 0; a < n; ++a)
+    {
+        m->h[a] = 0.0;
+        if (m->sizes[a] == 0) continue;
+        m->k++;
+        for (size_t g = 0; g < n; ++g)
+        {
+            double const p = m->w[a * n + g] / m->sizes[a];
+            m->h[a] += f(p);
+            m->col[g] += p;
+        }
+        m->s += m->h[a];
+    }
+}
+
+// The EI of the macro-scale matrix under a uniform intervention,
+// H(col / k) - s / k.
+static double macro_ei(macro_state const *m)
+{
+    double g = 0.0;
+    for (size_t a = 0; a < m->n; ++a)
+    {
+        if (m->sizes[a] != 0 && m->col[a] > 0.0)
+        {
+            g += m->col[a] * log2(m->col[a]);
+        }
+    }
+    return log2(m->k) - (g + m->s) / m->k;
+}
+
+// Remove (sign = -1) or restore (sign = +1) the contributions of the rows
+// and columns of the macro-states `a` and `b` to the row entropies and
+// column sums.
+static void macro_account(macro_state *m, size_t a, size_t b, double sign)
+{
+    size_t const n = m->n;
+    for (size_t x = 0; x < n; ++x)
+    {
+        if (m->sizes[x] == 0) continue;
+        double const *row = m->w + x * n;
+        if (x == a || x == b)
+        {
+            double h = 0.0;
+            for (size_t g = 0; g < n; ++g)
+            {
+                double const p = row[g] / m->sizes[x];
+                h += f(p);
+                m->col[g] += sign * p;
+            }
+            m->h[x] = (sign > 0.0) ? h : 0.0;
+            m->s += sign * h;
+        }
+        else
+        {
+            double const pa = row[a] / m->sizes[x], pb = row[b] / m->sizes[x];
+            double const dh = f(pa) + f(pb);
+            m->h[x] += sign * dh;
+            m->s += sign * dh;
+            m->col[a] += sign * pa;
+            m->col[b] += sign * pb;
+        }
+    }
+}
+
+// Move the micro-state `i` to the macro-state `b`.
+static void macro_move(macro_state *m, size_t i, size_t b)
+{
+    size_t const n = m->n, a = m->group[i];
+    double const *tpm = m->tpm;
+
+    macro_account(m, a, b, -1.0);
+
+    memset(m->rowagg, 0, n * sizeof(double));
+    memset(m->colagg, 0, n * sizeof(double));
+    for (size_t j = 0; j < n; ++j)
+    {
+        m->rowagg[m->group[j]] += tpm[i * n + j];
+        if (j != i)
+        {
+            m->colagg[m->group[j]] += tpm[j * n + i];
+        }
+    }
+    double const self = tpm[i * n + i];
+    for (size_t g = 0; g < n; ++g)
+    {
+        m->w[a * n + g] -= m->rowagg[g];
+        m->w[g * n + a] -= m->colagg[g];
+    }
+    m->rowagg[a] -= self;
+    m->rowagg[b] += self;
+    for (size_t g = 0; g < n; ++g)
+    {
+        m->w[b * n + g] += m->rowagg[g];
+        m->w[g * n + b] += m->colagg[g];
+    }
+
+    m->k += (m->sizes[b] == 0) - (m->sizes[a] == 1);
+    m->sizes[a]--;
+    m->sizes[b]++;
+    m->group[i] = b;
+    if (m->sizes[a] == 0)
+    {
+        // clear the rounding residue of the vacated macro-state
+        for (size_t g = 0; g < n; ++g)
+        {
+            m->w[a * n + g] = m->w[g * n + a] = 0.0;
+        }
+        m->col[a] = 0.0;
+    }
+
+    macro_account(m, a, b, +1.0);
+}
+
+inline static double g(double x)
+{
+    return (x > 0.0) ? x * log2(x) : 0.0;
+}
+
+// The quantities shared by the evaluations of every merge in a round of the
+// greedy search: the nonempty slots, the terms of the column sums in the EI,
+// and the normalised entries of the macro-scale matrix with their terms in
+// the row entropies.
+typedef struct merge_table
+{
+    size_t k;
+    size_t *active;
+    double *gcol;
+    double gsum;
+    double *p;
+    double *fp;
+} merge_table;
+
+static void merge_table_fill(merge_table *t, macro_state const *m)
+{
+    size_t const n = m->n;
+    t->k = 0;
+    t->gsum = 0.0;
+    for (size_t a = 0; a < n; ++a)
+    {
+        if (m->sizes[a] == 0) continue;
+        t->active[t->k++] = a;
+        t->gcol[a] = g(m->col[a]);
+        t->gsum += t->gcol[a];
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t u = 0; u < t->k; ++u)
+    {
+        size_t const x = t->active[u];
+        for (size_t v = 0; v < t->k; ++v)
+        {
+            size_t const y = t->active[v];
+            double const p = m->w[x * n + y] / m->sizes[x];
+            t->p[x * n + y] = p;
+            t->fp[x * n + y] = f(p);
+        }
+    }
+}
+
+// The EI after merging the macro-states `a` and `c`, without changing the
+// state. Only the entries in the rows and columns of `a` and `c` which are
+// nonzero contribute to the change.
+static double merge_ei(macro_state const *m, merge_table const *t, size_t a,
+    size_t c)
+{
+    size_t const n = m->n;
+    double const sa = m->sizes[a], sc = m->sizes[c], s = sa + sc;
+    double const *pa = t->p + a * n, *pc = t->p + c * n;
+
+    double hr = 0.0, dg = 0.0, ds = 0.0;
+    for (size_t u = 0; u < t->k; ++u)
+    {
+        size_t const x = t->active[u];
+        if (x == a || x == c) continue;
+        if (pa[x] != 0.0 || pc[x] != 0.0)
+        {
+            double const r = (sa * pa[x] + sc * pc[x]) / s;
+            hr += f(r);
+            dg += g(m->col[x] - pa[x] - pc[x] + r) - t->gcol[x];
+        }
+        double const *px = t->p + x * n, *fx = t->fp + x * n;
+        if (px[a] != 0.0 && px[c] != 0.0)
+        {
+            ds += f(px[a] + px[c]) - fx[a] - fx[c];
+        }
+    }
+    double const r = (sa * (pa[a] + pa[c]) + sc * (pc[a] + pc[c])) / s;
+    hr += f(r);
+    dg += g(m->col[a] + m->col[c] - pa[a] - pa[c] - pc[a] - pc[c] + r) -
+        t->gcol[a] - t->gcol[c];
+
+    double const k = m->k - 1;
+    double const entropies = m->s - m->h[a] - m->h[c] + hr + ds;
+    return log2(k) - (t->gsum + dg + entropies) / k;
+}
+
+typedef struct merge
+{
+    double gain;
+    size_t a, c;
+} merge;
+
+static int compare_merges(void const *x, void const *y)
+{
+    merge const *u = x, *v = y;
+    if (u->gain != v->gain) return (u->gain < v->gain) - (u->gain > v->gain);
+    if (u->a != v->a) return (u->a > v->a) - (u->a < v->a);
+    return (u->c > v->c) - (u->c < v->c);
+}
+
+// Merge the macro-state `c` into `a`, recording the moved micro-states.
+static size_t merge_into(macro_state *m, size_t a, size_t c, size_t *moved)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < m->n; ++i)
+    {
+        if (m->group[i] == c)
+        {
+            macro_move(m, i, a);
+            moved[count++] = i;
+        }
+    }
+    return count;
+}
+
+// In each round every pair of macro-states is evaluated, and each
+// macro-state's best improving merge with a later macro-state becomes a
+// candidate. The candidates are applied in order of decreasing gain, skipping
+// those which share a macro-state with a merge already made in the round and
+// undoing those which no longer increase the EI. The search stops after a
+// round without merges.
+static void greedy(macro_state *m, size_t *best_groups, double *best,
+    inform_error *err)
+{
+    size_t const n = m->n;
+    merge_table t;
+    t.active = malloc(3 * n * sizeof(size_t));
+    t.gcol = malloc(n * sizeof(double));
+    t.p = malloc(3 * n * n * sizeof(double));
+    merge *candidates = malloc(n * sizeof(merge));
+    if (!t.active || !t.gcol || !t.p || !candidates)
+    {
+        free(candidates);
+        free(t.p);
+        free(t.gcol);
+        free(t.active);
+        INFORM_ERROR_RETURN_VOID(err, INFORM_ENOMEM);
+    }
+    t.fp = t.p + n * n;
+    double *gains = t.fp + n * n;
+    size_t *moved = t.active + n;
+    bool *merged = (bool*)(moved + n);
+
+    double current = macro_ei(m);
+    bool progress = true;
+    while (m->k > 1 && progress)
+    {
+        merge_table_fill(&t, m);
+        size_t const k = t.k;
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (size_t u = 0; u < k; ++u)
+        {
+            for (size_t v = u + 1; v < k; ++v)
+            {
+                gains[u * k + v] = merge_ei(m, &t, t.active[u], t.active[v]) -
+                    current;
+            }
+        }
+
+        size_t ncandidates = 0;
+        for (size_t u = 0; u < k; ++u)
+        {
+            merge best_merge = { 1e-12, u, k };
+            for (size_t v = u + 1; v < k; ++v)
+            {
+                if (gains[u * k + v] > best_merge.gain)
+                {
+                    best_merge.gain = gains[u * k + v];
+                    best_merge.c = v;
+                }
+            }
+            if (best_merge.c < k)
+            {
+                candidates[ncandidates++] = best_merge;
+            }
+        }
+        qsort(candidates, ncandidates, sizeof(merge), compare_merges);
+
+        progress = false;
+        memset(merged, 0, k * sizeof(bool));
+        for (size_t i = 0; i < ncandidates; ++i)
+        {
+            size_t const u = candidates[i].a, v = candidates[i].c;
+            if (merged[u] || merged[v]) continue;
+            size_t const a = t.active[u], c = t.active[v];
+            size_t const count = merge_into(m, a, c, moved);
+            double const ei = macro_ei(m);
+            if (ei > current + 1e-12)
+            {
+                current = ei;
+                merged[u] = merged[v] = true;
+                progress = true;
+            }
+            else
+            {
+                for (size_t j = 0; j < count; ++j) macro_move(m, moved[j], c);
+            }
+        }
+    }
+    *best = current;
+    memcpy(best_groups, m->group, n * sizeof(size_t));
+
+    free(candidates);
+    free(t.p);
+    free(t.gcol);
+    free(t.active);
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double random_unit(uint64_t *state)
+{
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void anneal(macro_state *m, size_t iterations, uint64_t *rng,
+    size_t *best_groups, double *best)
+{
+    size_t const n = m->n;
+    double current = macro_ei(m);
+    *best = current;
+    memcpy(best_groups, m->group, n * sizeof(size_t));
+
+    for (size_t it = 0; it < iterations; ++it)
+    {
+        size_t const i = next_random(rng) % n, a = m->group[i];
+
+        // the destination is the macro-state of another micro-state, or
+        // (with the same probability as each macro-state) a new one
+        size_t b;
+        if (next_random(rng) % (m->k + 1) == 0)
+        {
+            if (m->sizes[a] == 1) continue;
+            b = 0;
+            while (m->sizes[b] != 0) ++b;
+        }
+        else
+        {
+            b = m->group[next_random(rng) % n];
+            if (b == a) continue;
+        }
+
+        macro_move(m, i, b);
+        double const proposal = macro_ei(m);
+        double const delta = proposal - current;
+        double const temperature = EMERGENCE_INITIAL_TEMPERATURE *
+            pow(EMERGENCE_FINAL_TEMPERATURE / EMERGENCE_INITIAL_TEMPERATURE,
+                (double) it / iterations);
+        if (delta >= 0.0 || random_unit(rng) < exp(delta / temperature))
+        {
+            current = proposal;
+            if (current > *best)
+            {
+                *best = current;
+                memcpy(best_groups, m->group, n * sizeof(size_t));
+            }
+        }
+        else
+        {
+            macro_move(m, i, a);
+        }
+    }
+}
+
+static bool check_tpm(double const *tpm, size_t n, inform_error *err)
+{
+    if (tpm == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETPM, true);
+    }
+    else if (n == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, true);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (!(tpm[i * n + j] >= 0.0))
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ETPM, true);
+            }
+            sum += tpm[i * n + j];
+        }
+        if (fabs(sum - 1.0) > 1e-6)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ETPM, true);
+        }
+    }
+    return false;
+}
+
+// Number the macro-states in order of first appearance.
+static void relabel(size_t *groups, size_t n, size_t *labels)
+{
+    size_t k = 0;
+    for (size_t a = 0; a < n; ++a) labels[a] = n;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (labels[groups[i]] == n) labels[groups[i]] = k++;
+        groups[i] = labels[groups[i]];
+    }
+}
+
+double *inform_macro_tpm(double const *tpm, size_t n, size_t const *groups,
+    size_t k, double *macro, inform_error *err)
+{
+    if (check_tpm(tpm, n, err))
+    {
+        return NULL;
+    }
+    else if (groups == NULL || k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+
+    size_t *sizes = calloc(k, sizeof(size_t));
+    if (sizes == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (groups[i] >= k)
+        {
+            free(sizes);
+            INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+        }
+        sizes[groups[i]]++;
+    }
+    for (size_t a = 0; a < k; ++a)
+    {
+        if (sizes[a] == 0)
+        {
+            free(sizes);
+            INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+        }
+    }
+
+    bool const allocate = (macro == NULL);
+    if (allocate)
+    {
+        macro = malloc(k * k * sizeof(double));
+        if (macro == NULL)
+        {
+            free(sizes);
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+    memset(macro, 0, k * k * sizeof(double));
+    for (size_t i = 0; i < n; ++i)
+    {
+        double *row = macro + groups[i] * k;
+        for (size_t j = 0; j < n; ++j)
+        {
+            row[groups[j]] += tpm[i * n + j] / sizes[groups[i]];
+        }
+    }
+
+    free(sizes);
+    return macro;
+}
+
+double inform_causal_emergence(double const *tpm, size_t n,
+    inform_emergence_search const *search, size_t *groups, inform_error *err)
+{
+    if (check_tpm(tpm, n, err))
+    {
+        return NAN;
+    }
+    else if (groups == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NAN);
+    }
+
+    inform_emergence_mode const mode = (search == NULL) ?
+        INFORM_EMERGENCE_GREEDY : search->mode;
+    size_t const restarts = (mode == INFORM_EMERGENCE_GREEDY ||
+        search->restarts == 0) ? 1 : search->restarts;
+
+    double best = -INFINITY;
+    size_t best_run = restarts;
+    // a single run parallelises its own search instead
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(restarts > 1)
+#endif
+    for (size_t run = 0; run < restarts; ++run)
+    {
+        inform_error run_err = INFORM_SUCCESS;
+        macro_state m;
+        size_t *run_groups = malloc(n * sizeof(size_t));
+        if (run_groups == NULL || !macro_alloc(&m, tpm, n))
+        {
+            free(run_groups);
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            INFORM_ERROR(err, INFORM_ENOMEM);
+            continue;
+        }
+
+        macro_init(&m, NULL);
+        double ei = NAN;
+        if (mode == INFORM_EMERGENCE_GREEDY)
+        {
+            greedy(&m, run_groups, &ei, &run_err);
+        }
+        else
+        {
+            uint64_t rng = search->seed ^ (0xD1B54A32D192ED03ULL * (run + 1));
+            anneal(&m, search->iterations, &rng, run_groups, &ei);
+        }
+
+        // evaluate the result afresh, free of accumulated rounding
+        if (inform_succeeded(&run_err))
+        {
+            macro_init(&m, run_groups);
+            ei = macro_ei(&m);
+        }
+        macro_free(&m);
+
+#ifdef _OPENMP
+        #pragma omp critical
+#endif
+        {
+            if (inform_failed(&run_err))
+            {
+                INFORM_ERROR(err, run_err);
+            }
+            else if (ei > best || (ei == best && run < best_run))
+            {
+                best = ei;
+                best_run = run;
+                memcpy(groups, run_groups, n * sizeof(size_t));
+            }
+        }
+        free(run_groups);
+    }
+
+    if (inform_failed(err))
+    {
+        return NAN;
+    }
+
+    size_t *labels = malloc(n * sizeof(size_t));
+    if (labels == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    relabel(groups, n, labels);
+    free(labels);
+
+    return best;
+}
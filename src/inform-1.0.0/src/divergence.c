@@ -0,0 +1,333 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/divergence.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// the largest base (relative to the length of the series) for which the
+/// distributions are stored densely rather than as sorted lists of states
+#define DIVERGENCE_DENSE_FACTOR 4
+
+// The distributions of a collection of series. Dense distributions have one
+// entry per state, with `missing` set for the states which are never
+// observed. Sparse distributions list the observed states in increasing
+// order, at most `n` per series, with `size` giving their number.
+typedef struct divergence_dists
+{
+    bool dense;
+    size_t stride;
+    int *states;
+    size_t *size;
+    double *probs;
+    double *logs;
+    double *missing;
+    double *entropy;
+} divergence_dists;
+
+static bool check_series(int const *series, size_t count, size_t n, int b,
+    inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (count == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, true);
+    }
+    for (size_t i = 0; i < count * n; ++i)
+    {
+        if (series[i] < 0)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+        }
+        else if (b <= series[i])
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+        }
+    }
+    return false;
+}
+
+static bool check_arguments(int const *ps, size_t np, int const *qs,
+    size_t nq, size_t n, int b, inform_divergence measure, inform_error *err)
+{
+    if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    else if (measure != INFORM_DIVERGENCE_RELATIVE &&
+        measure != INFORM_DIVERGENCE_CROSS &&
+        measure != INFORM_DIVERGENCE_JENSEN_SHANNON)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+    }
+    return check_series(ps, np, n, b, err) ||
+        (qs != ps && check_series(qs, nq, n, b, err));
+}
+
+static int compare_ints(void const *x, void const *y)
+{
+    int const a = *(int const *) x;
+    int const b = *(int const *) y;
+    return (a < b) ? -1 : (a > b) ? 1 : 0;
+}
+
+// The cross entropy -sum p log2 q of two dense distributions, flagging
+// whether p has a state that q does not.
+static double dense_cross(double const *p, double const *log_q,
+    double const *missing_q, size_t b, bool *missing)
+{
+    double cross = 0.0, miss = 0.0;
+#ifdef _OPENMP
+    #pragma omp simd reduction(+:cross,miss)
+#endif
+    for (size_t s = 0; s < b; ++s)
+    {
+        cross -= p[s] * log_q[s];
+        miss += p[s] * missing_q[s];
+    }
+    *missing = (miss > 0.0);
+    return cross;
+}
+
+static double sparse_cross(int const *p_states, double const *p,
+    size_t p_size, int const *q_states, double const *log_q, size_t q_size,
+    bool *missing)
+{
+    double cross = 0.0;
+    *missing = false;
+    for (size_t i = 0, j = 0; i < p_size; ++i)
+    {
+        while (j < q_size && q_states[j] < p_states[i]) ++j;
+        if (j == q_size || q_states[j] != p_states[i])
+        {
+            *missing = true;
+            continue;
+        }
+        cross -= p[i] * log_q[j];
+    }
+    return cross;
+}
+
+// The entropy of the even mixture of two dense distributions.
+static double dense_mixture_entropy(double const *p, double const *q,
+    size_t b)
+{
+    double h = 0.0;
+    for (size_t s = 0; s < b; ++s)
+    {
+        double const m = 0.5 * (p[s] + q[s]);
+        if (m > 0.0)
+        {
+            h -= m * log2(m);
+        }
+    }
+    return h;
+}
+
+static double sparse_mixture_entropy(int const *p_states, double const *p,
+    size_t p_size, int const *q_states, double const *q, size_t q_size)
+{
+    double h = 0.0;
+    size_t i = 0, j = 0;
+    while (i < p_size || j < q_size)
+    {
+        double m;
+        if (j == q_size || (i < p_size && p_states[i] < q_states[j]))
+        {
+            m = 0.5 * p[i++];
+        }
+        else if (i == p_size || q_states[j] < p_states[i])
+        {
+            m = 0.5 * q[j++];
+        }
+        else
+        {
+            m = 0.5 * (p[i++] + q[j++]);
+        }
+        h -= m * log2(m);
+    }
+    return h;
+}
+
+static double cross_entropy_of(divergence_dists const *p, size_t i,
+    divergence_dists const *q, size_t j, bool *missing)
+{
+    if (p->dense)
+    {
+        return dense_cross(p->probs + i * p->stride,
+            q->logs + j * q->stride, q->missing + j * q->stride, p->stride,
+            missing);
+    }
+    return sparse_cross(p->states + i * p->stride, p->probs + i * p->stride,
+        p->size[i], q->states + j * q->stride, q->logs + j * q->stride,
+        q->size[j], missing);
+}
+
+static void free_dists(divergence_dists *dists)
+{
+    free(dists->entropy);
+    free(dists->missing);
+    free(dists->logs);
+    free(dists->probs);
+    free(dists->size);
+    free(dists->states);
+}
+
+// Build the distribution of each of `count` series, in parallel when OpenMP
+// is available.
+static bool build_dists(int const *series, size_t count, size_t n, int b,
+    bool dense, divergence_dists *dists)
+{
+    memset(dists, 0, sizeof(divergence_dists));
+    dists->dense = dense;
+    dists->stride = dense ? (size_t) b : n;
+    size_t const size = count * dists->stride;
+
+    dists->probs = calloc(size, sizeof(double));
+    dists->logs = calloc(size, sizeof(double));
+    dists->entropy = malloc(count * sizeof(double));
+    if (dense)
+    {
+        dists->missing = malloc(size * sizeof(double));
+    }
+    else
+    {
+        dists->states = malloc(size * sizeof(int));
+        dists->size = malloc(count * sizeof(size_t));
+    }
+    if (dists->probs == NULL || dists->logs == NULL ||
+        dists->entropy == NULL || (dense && dists->missing == NULL) ||
+        (!dense && (dists->states == NULL || dists->size == NULL)))
+    {
+        free_dists(dists);
+        return false;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (size_t i = 0; i < count; ++i)
+    {
+        int const *x = series + i * n;
+        double *probs = dists->probs + i * dists->stride;
+        double *logs = dists->logs + i * dists->stride;
+        size_t support = dists->stride;
+        if (dense)
+        {
+            double *missing = dists->missing + i * dists->stride;
+            for (size_t t = 0; t < n; ++t)
+            {
+                probs[x[t]] += 1.0;
+            }
+            for (size_t s = 0; s < support; ++s)
+            {
+                missing[s] = (probs[s] == 0.0) ? 1.0 : 0.0;
+            }
+        }
+        else
+        {
+            int *states = dists->states + i * dists->stride;
+            memcpy(states, x, n * sizeof(int));
+            qsort(states, n, sizeof(int), compare_ints);
+            support = 0;
+            for (size_t t = 0; t < n; ++t)
+            {
+                if (t == 0 || states[t] != states[support - 1])
+                {
+                    states[support++] = states[t];
+                }
+                probs[support - 1] += 1.0;
+            }
+            dists->size[i] = support;
+        }
+        for (size_t s = 0; s < support; ++s)
+        {
+            probs[s] /= n;
+            logs[s] = (probs[s] > 0.0) ? log2(probs[s]) : 0.0;
+        }
+        bool missing;
+        dists->entropy[i] = cross_entropy_of(dists, i, dists, i, &missing);
+    }
+    return true;
+}
+
+double *inform_divergence_matrix(int const *ps, size_t np, int const *qs,
+    size_t nq, size_t n, int b, inform_divergence measure, double *d,
+    inform_error *err)
+{
+    if (check_arguments(ps, np, qs, nq, n, b, measure, err))
+    {
+        return NULL;
+    }
+
+    bool const dense = ((size_t) b <= DIVERGENCE_DENSE_FACTOR * n);
+    bool const shared = (ps == qs && np == nq);
+    divergence_dists p, q;
+    if (!build_dists(ps, np, n, b, dense, &p))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    if (!shared && !build_dists(qs, nq, n, b, dense, &q))
+    {
+        free_dists(&p);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    divergence_dists const *qd = shared ? &p : &q;
+
+    bool const allocate = (d == NULL);
+    if (allocate)
+    {
+        d = malloc(np * nq * sizeof(double));
+        if (d == NULL)
+        {
+            if (!shared) free_dists(&q);
+            free_dists(&p);
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (size_t k = 0; k < np * nq; ++k)
+    {
+        size_t const i = k / nq, j = k % nq;
+        if (measure == INFORM_DIVERGENCE_JENSEN_SHANNON)
+        {
+            double const h = dense ?
+                dense_mixture_entropy(p.probs + i * p.stride,
+                    qd->probs + j * qd->stride, p.stride) :
+                sparse_mixture_entropy(p.states + i * p.stride,
+                    p.probs + i * p.stride, p.size[i],
+                    qd->states + j * qd->stride, qd->probs + j * qd->stride,
+                    qd->size[j]);
+            d[k] = h - 0.5 * (p.entropy[i] + qd->entropy[j]);
+        }
+        else
+        {
+            bool missing;
+            double const cross = cross_entropy_of(&p, i, qd, j, &missing);
+            if (measure == INFORM_DIVERGENCE_CROSS)
+            {
+                d[k] = missing ? INFINITY : cross;
+            }
+            else
+            {
+                d[k] = missing ? NAN : cross - p.entropy[i];
+            }
+        }
+    }
+
+    if (!shared) free_dists(&q);
+    free_dists(&p);
+
+    return d;
+}
@@ -3,6 +3,7 @@
 // license that can be found in the LICENSE file.
 #include <inform/dist.h>
 #include <inform/effective_info.h>
+#include <inform/utilities.h>
 #include <math.h>
 
 static inline double sum_row(double const *row, size_t n)
@@ -121,3 +122,309 @@ double inform_effective_info(double const *tpm, double const *inter, size_t n,
 
     return ei;
 }
+
+static int check_sparse_arguments(inform_sparse_tpm const *tpm,
+    double const *inter, inform_error *err)
+{
+    if (tpm == NULL || tpm->offsets == NULL ||
+        (tpm->nnz != 0 && (tpm->columns == NULL || tpm->values == NULL)))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+    }
+    else if (tpm->size == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, 1);
+    }
+    else if (tpm->offsets[0] != 0 || tpm->offsets[tpm->size] != tpm->nnz)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+    }
+
+    for (size_t i = 0; i < tpm->size; ++i)
+    {
+        if (tpm->offsets[i + 1] < tpm->offsets[i])
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+        }
+        double sum = 0.0;
+        for (size_t k = tpm->offsets[i]; k < tpm->offsets[i + 1]; ++k)
+        {
+            if (tpm->columns[k] >= tpm->size || !(tpm->values[k] >= 0.0))
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+            }
+            sum += tpm->values[k];
+        }
+        if (fabs(sum - 1.0) > 1e-6)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+        }
+    }
+
+    if (inter != NULL)
+    {
+        double const sum = sum_row(inter, tpm->size);
+        if (isnan(sum))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EDIST, 1);
+        }
+        if (fabs(sum - 1.0) > 1e-6)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EDIST, 1);
+        }
+    }
+
+    return 0;
+}
+
+double inform_effective_info_sparse(inform_sparse_tpm const *tpm,
+    double const *inter, inform_error *err)
+{
+    if (check_sparse_arguments(tpm, inter, err))
+    {
+        return NAN;
+    }
+
+    size_t const n = tpm->size;
+    double *ed = calloc(n, sizeof(double));
+    if (ed == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+
+    // compute the ED given the ID and TPM
+    double const k = 1.0 / n;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double const id = (inter != NULL) ? inter[i] : k;
+        for (size_t j = tpm->offsets[i]; j < tpm->offsets[i + 1]; ++j)
+        {
+            ed[tpm->columns[j]] += id * tpm->values[j];
+        }
+    }
+
+    // and compute the effective information
+    double ei = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double const id = (inter != NULL) ? inter[i] : k;
+        double kld = 0.0;
+        for (size_t j = tpm->offsets[i]; j < tpm->offsets[i + 1]; ++j)
+        {
+            double const p = tpm->values[j];
+            if (p != 0)
+            {
+                kld += p * log2(p / ed[tpm->columns[j]]);
+            }
+        }
+        ei += id * kld;
+    }
+
+    free(ed);
+
+    return ei;
+}
+
+/// the largest Boolean network whose effective information can be computed
+#define NETWORK_MAX_NODES 30
+/// the number of states of a Boolean network in each parallel shard
+#define NETWORK_SHARD_SIZE 1024
+
+static int check_network_arguments(size_t nodes, size_t const *k,
+    size_t const *inputs, double const *tables, double const *inter,
+    inform_error *err)
+{
+    if (nodes == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, 1);
+    }
+    else if (nodes > NETWORK_MAX_NODES)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, 1);
+    }
+    else if (k == NULL || tables == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+    }
+
+    size_t nin = 0, ntable = 0;
+    for (size_t i = 0; i < nodes; ++i)
+    {
+        if (k[i] > nodes)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EARG, 1);
+        }
+        for (size_t j = 0; j < k[i]; ++j)
+        {
+            if (inputs == NULL || inputs[nin + j] >= nodes)
+            {
+                INFORM_ERROR_RETURN(err, INFORM_EARG, 1);
+            }
+        }
+        for (size_t j = 0; j < ((size_t)1 << k[i]); ++j)
+        {
+            double const p = tables[ntable + j];
+            if (!(0.0 <= p && p <= 1.0))
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ETPM, 1);
+            }
+        }
+        nin += k[i];
+        ntable += (size_t)1 << k[i];
+    }
+
+    if (inter != NULL)
+    {
+        double const sum = sum_row(inter, (size_t)1 << nodes);
+        if (isnan(sum))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EDIST, 1);
+        }
+        if (fabs(sum - 1.0) > 1e-6)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EDIST, 1);
+        }
+    }
+
+    return 0;
+}
+
+// Distribute the weight `w` of a state over its successors, branching on each
+// of its noisy nodes in turn; `state` has the deterministic nodes set.
+static void spread(double *ed, size_t const *noisy, double const *ps,
+    size_t nnoisy, size_t state, double w)
+{
+    if (nnoisy == 0)
+    {
+#ifdef _OPENMP
+        #pragma omp atomic
+#endif
+        ed[state] += w;
+        return;
+    }
+    double const p = ps[noisy[0]];
+    spread(ed, noisy + 1, ps, nnoisy - 1, state | ((size_t)1 << noisy[0]), w * p);
+    spread(ed, noisy + 1, ps, nnoisy - 1, state, w * (1.0 - p));
+}
+
+// the entropy (in bits) of a Bernoulli random variable
+inline static double bernoulli_entropy(double p)
+{
+    if (p == 0.0 || p == 1.0)
+    {
+        return 0.0;
+    }
+    return -p * log2(p) - (1.0 - p) * log2(1.0 - p);
+}
+
+double inform_effective_info_boolean(size_t nodes, size_t const *k,
+    size_t const *inputs, double const *tables, double const *inter,
+    inform_error *err)
+{
+    if (check_network_arguments(nodes, k, inputs, tables, inter, err))
+    {
+        return NAN;
+    }
+
+    size_t const n = (size_t)1 << nodes;
+    double *ed = calloc(n, sizeof(double));
+    size_t *offsets = malloc(2 * nodes * sizeof(size_t));
+    if (ed == NULL || offsets == NULL)
+    {
+        free(offsets);
+        free(ed);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    // the offsets of each node's inputs and truth table
+    size_t *input_offsets = offsets, *table_offsets = offsets + nodes;
+    for (size_t i = 0, nin = 0, ntable = 0; i < nodes; ++i)
+    {
+        input_offsets[i] = nin;
+        table_offsets[i] = ntable;
+        nin += k[i];
+        ntable += (size_t)1 << k[i];
+    }
+
+    // Each state contributes its weight to the ED over its successors, and
+    // the entropy of its successors (the sum of its nodes' entropies) to the
+    // conditional entropy. The EI is then H(ED) - H(future|intervention).
+    double const uniform = 1.0 / n;
+    double conditional = 0.0;
+    size_t const nshards = (n + NETWORK_SHARD_SIZE - 1) / NETWORK_SHARD_SIZE;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(+:conditional)
+#endif
+    for (size_t shard = 0; shard < nshards; ++shard)
+    {
+        size_t *noisy = malloc(nodes * sizeof(size_t));
+        double *ps = malloc(nodes * sizeof(double));
+        if (noisy == NULL || ps == NULL)
+        {
+            free(ps);
+            free(noisy);
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            INFORM_ERROR(err, INFORM_ENOMEM);
+            continue;
+        }
+
+        size_t const stop = MIN(n, (shard + 1) * NETWORK_SHARD_SIZE);
+        for (size_t state = shard * NETWORK_SHARD_SIZE; state < stop; ++state)
+        {
+            double const w = (inter != NULL) ? inter[state] : uniform;
+            if (w == 0.0)
+            {
+                continue;
+            }
+
+            size_t nnoisy = 0, successor = 0;
+            double h = 0.0;
+            for (size_t i = 0; i < nodes; ++i)
+            {
+                size_t const *in = inputs + input_offsets[i];
+                size_t index = 0;
+                for (size_t j = 0; j < k[i]; ++j)
+                {
+                    index = (index << 1) | ((state >> (nodes - 1 - in[j])) & 1);
+                }
+                double const p = tables[table_offsets[i] + index];
+                size_t const bit = nodes - 1 - i;
+                ps[bit] = p;
+                successor |= (size_t)(p == 1.0) << bit;
+                if (0.0 < p && p < 1.0)
+                {
+                    noisy[nnoisy++] = bit;
+                    h += bernoulli_entropy(p);
+                }
+            }
+            conditional += w * h;
+            spread(ed, noisy, ps, nnoisy, successor, w);
+        }
+
+        free(ps);
+        free(noisy);
+    }
+
+    double ei = NAN;
+    if (inform_succeeded(err))
+    {
+        double entropy = 0.0;
+#ifdef _OPENMP
+        #pragma omp parallel for reduction(+:entropy)
+#endif
+        for (size_t state = 0; state < n; ++state)
+        {
+            if (ed[state] > 0.0)
+            {
+                entropy -= ed[state] * log2(ed[state]);
+            }
+        }
+        ei = entropy - conditional;
+    }
+
+    free(offsets);
+    free(ed);
+
+    return ei;
+}
@@ -0,0 +1,403 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/gaussian.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/// relative tolerance below which a (conditional) variance is considered zero
+#define GAUSSIAN_TOL 1e-10
+
+static void accumulate_moments(double const *x, size_t d, double const *shift,
+    double *sums, double *cross)
+{
+    for (size_t i = 0; i < d; ++i)
+    {
+        double const y = x[i] - shift[i];
+        sums[i] += y;
+        for (size_t j = 0; j <= i; ++j)
+        {
+            cross[i*d + j] += y * (x[j] - shift[j]);
+        }
+    }
+}
+
+static void finalize_covariance(size_t d, uint64_t N, double const *sums,
+    double *cov)
+{
+    for (size_t i = 0; i < d; ++i)
+    {
+        for (size_t j = 0; j <= i; ++j)
+        {
+            double c = cov[i*d + j] / N - (sums[i] / N) * (sums[j] / N);
+            cov[i*d + j] = cov[j*d + i] = c;
+        }
+    }
+}
+
+static size_t cholesky(double const *cov, size_t d, size_t const *idx, size_t s,
+    double *L)
+{
+    for (size_t i = 0; i < s; ++i)
+    {
+        double const *row = cov + idx[i]*d;
+        for (size_t j = 0; j < i; ++j)
+        {
+            double sum = row[idx[j]];
+            for (size_t p = 0; p < j; ++p)
+            {
+                sum -= L[i*s + p] * L[j*s + p];
+            }
+            L[i*s + j] = sum / L[j*s + j];
+        }
+        double sum = row[idx[i]];
+        for (size_t p = 0; p < i; ++p)
+        {
+            sum -= L[i*s + p] * L[i*s + p];
+        }
+        if (!(sum > GAUSSIAN_TOL * row[idx[i]]))
+        {
+            return i;
+        }
+        L[i*s + i] = sqrt(sum);
+    }
+    return s;
+}
+
+static double residual(double const *cov, size_t d, size_t const *idx,
+    size_t s, double const *L, size_t y, double *w, double *partial)
+{
+    double const *row = cov + y*d;
+    double r = row[y];
+    if (partial != NULL) *partial = r;
+    for (size_t i = 0; i < s; ++i)
+    {
+        double sum = row[idx[i]];
+        for (size_t p = 0; p < i; ++p)
+        {
+            sum -= L[i*s + p] * w[p];
+        }
+        w[i] = sum / L[i*s + i];
+        if (partial != NULL && i + 1 == s) *partial = r;
+        r -= w[i] * w[i];
+    }
+    return r;
+}
+
+static double information_gain(double const *cov, size_t d, size_t const *idx,
+    size_t s, double const *L, size_t x, double *w)
+{
+    double r_z, r_zy = residual(cov, d, idx, s, L, x, w, &r_z);
+    if (!(r_z > GAUSSIAN_TOL * cov[x*d + x]))
+    {
+        return 0.0;
+    }
+    else if (!(r_zy > 0.0))
+    {
+        return INFINITY;
+    }
+    return 0.5 * log2(r_z / r_zy);
+}
+
+static double conditional_mutual_info(double const *cov, size_t d, size_t x,
+    size_t y, size_t const *z, size_t nz, size_t *idx, double *L, double *w,
+    inform_error *err)
+{
+    memcpy(idx, z, nz * sizeof(size_t));
+    idx[nz] = y;
+    size_t rank = cholesky(cov, d, idx, nz + 1, L);
+    if (rank < nz)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ECOV, NAN);
+    }
+    else if (rank == nz)
+    {
+        return 0.0;
+    }
+    return information_gain(cov, d, idx, nz + 1, L, x, w);
+}
+
+double inform_gaussian_mutual_info(double const *series, size_t l, size_t n,
+    inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NAN);
+    }
+    else if (l < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NAN);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NAN);
+    }
+
+    double *data = calloc(2*l*l + 3*l, sizeof(double));
+    size_t *idx = malloc(l * sizeof(size_t));
+    if (data == NULL || idx == NULL)
+    {
+        free(data);
+        free(idx);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    double *cov = data, *L = cov + l*l, *sums = L + l*l, *shift = sums + l;
+    double *x = shift + l;
+
+    for (size_t j = 0; j < l; ++j)
+    {
+        shift[j] = series[n*j];
+        idx[j] = j;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < l; ++j) x[j] = series[i + n*j];
+        accumulate_moments(x, l, shift, sums, cov);
+    }
+    finalize_covariance(l, n, sums, cov);
+
+    double mi = 0.0;
+    for (size_t j = 0; j < l && !isnan(mi); ++j)
+    {
+        if (cov[j*l + j] > 0.0)
+        {
+            mi += log(cov[j*l + j]);
+        }
+        else
+        {
+            mi = NAN;
+        }
+    }
+    if (isnan(mi))
+    {
+        INFORM_ERROR(err, INFORM_ECOV);
+    }
+    else if (cholesky(cov, l, idx, l, L) == l)
+    {
+        for (size_t j = 0; j < l; ++j) mi -= 2.0 * log(L[j*l + j]);
+        mi = 0.5 * mi / log(2.0);
+    }
+    else
+    {
+        mi = INFINITY;
+    }
+
+    free(idx);
+    free(data);
+
+    return mi;
+}
+
+double inform_gaussian_conditional_entropy(double const *xs, double const *ys,
+    size_t n, inform_error *err)
+{
+    if (xs == NULL || ys == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NAN);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NAN);
+    }
+
+    double cov[4] = {0.0, 0.0, 0.0, 0.0}, sums[2] = {0.0, 0.0};
+    double shift[2] = {xs[0], ys[0]};
+    for (size_t i = 0; i < n; ++i)
+    {
+        double x[2] = {xs[i], ys[i]};
+        accumulate_moments(x, 2, shift, sums, cov);
+    }
+    finalize_covariance(2, n, sums, cov);
+
+    double r = cov[3];
+    if (cov[0] > 0.0)
+    {
+        r -= cov[1] * cov[1] / cov[0];
+    }
+    if (!(r > GAUSSIAN_TOL * cov[3]))
+    {
+        return -INFINITY;
+    }
+    return 0.5 * log2(2.0 * acos(-1.0) * exp(1.0) * r);
+}
+
+static bool check_arguments(double const *src, double const *dst,
+    double const *back, size_t l, size_t n, size_t m, size_t k,
+    inform_error *err)
+{
+    if (src == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (dst == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (back == NULL && l != 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, true);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, true);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, true);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, true);
+    }
+    return false;
+}
+
+double inform_gaussian_transfer_entropy(double const *src, double const *dst,
+    double const *back, size_t l, size_t n, size_t m, size_t k,
+    inform_error *err)
+{
+    if (check_arguments(src, dst, back, l, n, m, k, err)) return NAN;
+
+    // observation layout: [future, source, history (k), background (l)]
+    size_t const d = k + l + 2;
+    double *data = calloc(2*d*d + 3*d, sizeof(double));
+    size_t *idx = malloc(2 * d * sizeof(size_t));
+    if (data == NULL || idx == NULL)
+    {
+        free(data);
+        free(idx);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    double *cov = data, *L = cov + d*d, *sums = L + d*d, *shift = sums + d;
+    double *x = shift + d;
+    size_t *z = idx + d;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = k; j < m; ++j)
+        {
+            x[0] = dst[j + m*i];
+            x[1] = src[j - 1 + m*i];
+            for (size_t p = 0; p < k; ++p)
+            {
+                x[2 + p] = dst[j - 1 - p + m*i];
+            }
+            for (size_t u = 0; u < l; ++u)
+            {
+                x[2 + k + u] = back[j - 1 + m*(i + n*u)];
+            }
+            if (i == 0 && j == k)
+            {
+                memcpy(shift, x, d * sizeof(double));
+            }
+            accumulate_moments(x, d, shift, sums, cov);
+        }
+    }
+    finalize_covariance(d, n * (m - k), sums, cov);
+
+    for (size_t p = 0; p < d - 2; ++p) z[p] = p + 2;
+    double te = conditional_mutual_info(cov, d, 1, 0, z, d - 2, idx, L, x, err);
+
+    free(idx);
+    free(data);
+
+    return te;
+}
+
+double *inform_gaussian_transfer_entropy_matrix(double const *series,
+    size_t l, size_t n, size_t m, size_t k, double *te, inform_error *err)
+{
+    if (check_arguments(series, series, NULL, 0, n, m, k, err)) return NULL;
+    else if (l < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+    }
+
+    bool allocate = (te == NULL);
+    if (allocate)
+    {
+        te = malloc(l * l * sizeof(double));
+        if (te == NULL)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+
+    // embedded observation layout: series v at lag p is at v*(k+1) + p
+    size_t const q = k + 1;
+    size_t const d = l * q;
+    double *data = calloc(d*d + q*q + 3*d, sizeof(double));
+    size_t *idx = malloc(q * sizeof(size_t));
+    if (data == NULL || idx == NULL)
+    {
+        free(data);
+        free(idx);
+        if (allocate) free(te);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    double *cov = data, *L = cov + d*d, *sums = L + q*q, *shift = sums + d;
+    double *x = shift + d;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = k; j < m; ++j)
+        {
+            for (size_t v = 0; v < l; ++v)
+            {
+                double const *s = series + m*(i + n*v) + j;
+                for (size_t p = 0; p < q; ++p)
+                {
+                    x[v*q + p] = *(s - p);
+                }
+            }
+            if (i == 0 && j == k)
+            {
+                memcpy(shift, x, d * sizeof(double));
+            }
+            accumulate_moments(x, d, shift, sums, cov);
+        }
+    }
+    finalize_covariance(d, n * (m - k), sums, cov);
+
+    for (size_t dst = 0; dst < l && inform_succeeded(err); ++dst)
+    {
+        // the history and future of the destination are factored once and
+        // shared by every source
+        for (size_t p = 0; p < k; ++p) idx[p] = dst*q + p + 1;
+        idx[k] = dst*q;
+        size_t rank = cholesky(cov, d, idx, q, L);
+        if (rank < k)
+        {
+            INFORM_ERROR(err, INFORM_ECOV);
+            break;
+        }
+        for (size_t src = 0; src < l; ++src)
+        {
+            if (src == dst || rank == k)
+            {
+                te[src + l*dst] = 0.0;
+            }
+            else
+            {
+                te[src + l*dst] = information_gain(cov, d, idx, q, L,
+                    src*q + 1, x);
+            }
+        }
+    }
+
+    free(idx);
+    free(data);
+
+    if (inform_failed(err))
+    {
+        if (allocate) free(te);
+        return NULL;
+    }
+
+    return te;
+}
@@ -6,6 +6,10 @@
 #include <inform/mutual_info.h>
 #include <inform/utilities/black_boxing.h>
 #include <math.h>
+#include <string.h>
+
+/// the largest joint histogram (in bins) of a source and destination group
+#define FLOW_MAX_STATES ((size_t) 1 << 32)
 
 static void accumulate_observations(int const *src, int const *dst,
     int const *back, size_t l_src, size_t l_dst, size_t l_back,
@@ -46,6 +50,23 @@ static void accumulate_observations(int const *src, int const *dst,
     }
 }
 
+static bool check_states(int const *series, size_t size, int b,
+    inform_error *err)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (b <= series[i])
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+        }
+        else if (series[i] < 0)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+        }
+    }
+    return false;
+}
+
 static bool check_arguments(int const *src, int const *dst, int const *back,
     size_t l_src, size_t l_dst, size_t l_back, size_t n, size_t m, int b,
     inform_error *err)
@@ -74,43 +95,9 @@ static bool check_arguments(int const *src, int const *dst, int const *back,
     {
         INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
     }
-    for (size_t i = 0; i < l_src * n * m; ++i)
-    {
-        if (b <= src[i])
-        {
-            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
-        }
-        else if (src[i] < 0)
-        {
-            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
-        }
-    }
-    for (size_t i = 0; i < l_dst * n * m; ++i)
-    {
-        if (b <= dst[i])
-        {
-            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
-        }
-        else if (dst[i] < 0)
-        {
-            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
-        }
-    }
-    if (back != NULL)
-    {
-        for (size_t i = 0; i < l_back * n * m; ++i)
-        {
-            if (b <= back[i])
-            {
-                INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
-            }
-            else if (back[i] < 0)
-            {
-                INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
-            }
-        }
-    }
-    return false;
+    return check_states(src, l_src * n * m, b, err) ||
+        check_states(dst, l_dst * n * m, b, err) ||
+        (back != NULL && check_states(back, l_back * n * m, b, err));
 }
 
 static double mutual_info(int const *src, int const *dst, size_t l_src,
@@ -238,3 +225,234 @@ double inform_information_flow(int const *src, int const *dst, int const *back,
 
     return flow / N;
 }
+
+static bool check_groups(size_t const *vars, size_t const *sizes,
+    size_t ngroups, size_t l, inform_error *err)
+{
+    if (vars == NULL || sizes == NULL || ngroups == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+    }
+    for (size_t g = 0, k = 0; g < ngroups; ++g)
+    {
+        if (sizes[g] == 0)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+        }
+        for (size_t end = k + sizes[g]; k < end; ++k)
+        {
+            if (vars[k] >= l)
+            {
+                INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+            }
+        }
+    }
+    return false;
+}
+
+static bool check_matrix_arguments(int const *series, size_t l,
+    size_t const *srcs, size_t const *src_sizes, size_t nsrc,
+    size_t const *dsts, size_t const *dst_sizes, size_t ndst,
+    int const *back, size_t l_back, size_t n, size_t m, int b,
+    inform_error *err)
+{
+    if (series == NULL || l == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (back == NULL && l_back != 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, true);
+    }
+    else if (m < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    return check_groups(srcs, src_sizes, nsrc, l, err) ||
+        check_groups(dsts, dst_sizes, ndst, l, err) ||
+        check_states(series, l * n * m, b, err) ||
+        (back != NULL && check_states(back, l_back * n * m, b, err));
+}
+
+// Encode the variables `vars` (or the first `size` variables if `vars` is
+// NULL) into a single state per observation, the first variable being the
+// most significant. Each variable is folded in with one pass over the
+// observations.
+static void encode(int const *series, size_t const *vars, size_t size,
+    size_t N, int b, int *codes)
+{
+    memset(codes, 0, N * sizeof(int));
+    for (size_t k = 0; k < size; ++k)
+    {
+        int const *x = series + ((vars != NULL) ? vars[k] : k) * N;
+        for (size_t t = 0; t < N; ++t)
+        {
+            codes[t] = codes[t] * b + x[t];
+        }
+    }
+}
+
+static size_t largest_group(size_t const *sizes, size_t ngroups)
+{
+    size_t largest = 0;
+    for (size_t g = 0; g < ngroups; ++g)
+    {
+        largest = (largest < sizes[g]) ? sizes[g] : largest;
+    }
+    return largest;
+}
+
+// The information flow from one encoded group to another given the encoded
+// background and its histogram `s`, accumulating the remaining histograms
+// in `scratch`.
+static double pair_flow(int const *src, size_t a_size, int const *dst,
+    size_t b_size, int const *back, uint32_t const *s, size_t s_size,
+    size_t N, uint32_t *scratch)
+{
+    size_t const bs_size = b_size * s_size;
+    uint32_t *joint = scratch;
+    uint32_t *as = joint + a_size * bs_size;
+    uint32_t *bs = as + a_size * s_size;
+    memset(scratch, 0, (a_size * bs_size + a_size * s_size + bs_size) *
+        sizeof(uint32_t));
+
+    for (size_t t = 0; t < N; ++t)
+    {
+        size_t const bs_state = dst[t] * s_size + back[t];
+        joint[src[t] * bs_size + bs_state]++;
+        as[src[t] * s_size + back[t]]++;
+        bs[bs_state]++;
+    }
+
+    double flow = 0.0;
+    for (size_t s_state = 0; s_state < s_size; ++s_state)
+    {
+        double const ns = s[s_state];
+        if (ns == 0)
+        {
+            continue;
+        }
+        for (size_t b_state = 0; b_state < b_size; ++b_state)
+        {
+            size_t const bs_state = b_state * s_size + s_state;
+            double const nbs = bs[bs_state];
+            if (nbs == 0)
+            {
+                continue;
+            }
+            for (size_t a_state = 0; a_state < a_size; ++a_state)
+            {
+                double const nas = as[a_state * s_size + s_state];
+                double const njoint = joint[a_state * bs_size + bs_state];
+                if (nas == 0 || njoint == 0)
+                {
+                    continue;
+                }
+                flow += njoint * log2((njoint * ns) / (nas * nbs));
+            }
+        }
+    }
+    return flow / N;
+}
+
+double *inform_information_flow_matrix(int const *series, size_t l,
+    size_t const *srcs, size_t const *src_sizes, size_t nsrc,
+    size_t const *dsts, size_t const *dst_sizes, size_t ndst,
+    int const *back, size_t l_back, size_t n, size_t m, int b, double *flows,
+    inform_error *err)
+{
+    if (check_matrix_arguments(series, l, srcs, src_sizes, nsrc, dsts,
+        dst_sizes, ndst, back, l_back, n, m, b, err))
+    {
+        return NULL;
+    }
+
+    size_t const N = n * m;
+    size_t const l_src = largest_group(src_sizes, nsrc);
+    size_t const l_dst = largest_group(dst_sizes, ndst);
+    if (pow((double) b, (double) (l_src + l_dst + l_back)) >
+        (double) FLOW_MAX_STATES)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t const a_size = pow((double) b, (double) l_src);
+    size_t const b_size = pow((double) b, (double) l_dst);
+    size_t const s_size = pow((double) b, (double) l_back);
+    size_t const scratch_size = a_size * b_size * s_size +
+        a_size * s_size + b_size * s_size;
+
+    bool const allocate = (flows == NULL);
+    int *codes = malloc((nsrc + ndst + 1) * N * sizeof(int));
+    uint32_t *s = calloc(s_size, sizeof(uint32_t));
+    if (allocate) flows = malloc(nsrc * ndst * sizeof(double));
+    if (codes == NULL || s == NULL || flows == NULL)
+    {
+        if (allocate) free(flows);
+        free(s);
+        free(codes);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    // every group and the background are encoded exactly once
+    int *src_codes = codes, *dst_codes = codes + nsrc * N;
+    int *back_codes = dst_codes + ndst * N;
+    for (size_t g = 0, k = 0; g < nsrc; k += src_sizes[g++])
+    {
+        encode(series, srcs + k, src_sizes[g], N, b, src_codes + g * N);
+    }
+    for (size_t g = 0, k = 0; g < ndst; k += dst_sizes[g++])
+    {
+        encode(series, dsts + k, dst_sizes[g], N, b, dst_codes + g * N);
+    }
+    encode(back, NULL, l_back, N, b, back_codes);
+    for (size_t t = 0; t < N; ++t)
+    {
+        s[back_codes[t]]++;
+    }
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *scratch = malloc(scratch_size * sizeof(uint32_t));
+        if (scratch == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (size_t p = 0; p < nsrc * ndst; ++p)
+        {
+            if (scratch == NULL) continue;
+            size_t const i = p / ndst, j = p % ndst;
+            flows[p] = pair_flow(src_codes + i * N,
+                pow((double) b, (double) src_sizes[i]), dst_codes + j * N,
+                pow((double) b, (double) dst_sizes[j]), back_codes, s, s_size,
+                N, scratch);
+        }
+        free(scratch);
+    }
+
+    free(s);
+    free(codes);
+
+    if (failed)
+    {
+        if (allocate) free(flows);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return flows;
+}
@@ -5,6 +5,8 @@
 #include <inform/mutual_info.h>
 #include <inform/utilities.h>
 #include <math.h>
+#include <string.h>
+#include <time.h>
 
 static bool check_arguments(int const *series, size_t l, inform_error *err)
 {
@@ -21,6 +23,319 @@ static bool check_arguments(int const *series, size_t l, inform_error *err)
     return false;
 }
 
+/// the largest number of variables for which subset entropies are memoised
+#define INTEGRATION_MAX_CACHED 20
+/// the most memory (in bytes) the memoised encodings and entropies may use
+#define INTEGRATION_CACHE_BYTES ((size_t) 1 << 30)
+/// the number of consecutive partitionings enumerated by each task
+#define INTEGRATION_SHARD_SIZE 4096
+
+// A memo of the encoded series and local entropies of subsets of the
+// variables, keyed by the bitmask of the subset.
+typedef struct subset_cache
+{
+    int const *series;
+    size_t l, n;
+    int const *b;
+    int **encodings;
+    double **entropies;
+    int *scratch;
+    uint64_t *codes;
+    size_t *counts;
+} subset_cache;
+
+// Whether the encodings and entropies of every subset of `l` variables with
+// `n` observations each fit in the memory budget of the cache, since a
+// complete search fills all of them.
+static bool cache_fits(size_t l, size_t n)
+{
+    size_t const per_subset = n * (sizeof(int) + sizeof(double));
+    return l <= INTEGRATION_MAX_CACHED &&
+        n <= INTEGRATION_CACHE_BYTES / (sizeof(int) + sizeof(double)) &&
+        per_subset <= (INTEGRATION_CACHE_BYTES >> l);
+}
+
+static bool check_states(int const *series, size_t l, size_t n, int const *b,
+    inform_error *err)
+{
+    if (n == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    for (size_t i = 0; i < l; ++i)
+    {
+        if (b[i] < 2)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+        }
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (series[j + n * i] < 0)
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+            }
+            else if (b[i] <= series[j + n * i])
+            {
+                INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+            }
+        }
+    }
+    return false;
+}
+
+static bool subset_cache_init(subset_cache *cache, int const *series,
+    size_t l, size_t n, int const *b, bool memoise)
+{
+    size_t states = n;
+    for (size_t i = 0; i < l; ++i)
+    {
+        states = ((size_t) b[i] > states) ? (size_t) b[i] : states;
+    }
+    cache->series = series;
+    cache->l = l;
+    cache->n = n;
+    cache->b = b;
+    cache->encodings = NULL;
+    cache->entropies = NULL;
+    if (memoise)
+    {
+        size_t const size = (size_t)1 << l;
+        cache->encodings = calloc(size, sizeof(int*));
+        cache->entropies = calloc(size, sizeof(double*));
+    }
+    cache->scratch = malloc(n * sizeof(int));
+    cache->codes = malloc(n * sizeof(uint64_t));
+    cache->counts = malloc(states * sizeof(size_t));
+    return (!memoise || (cache->encodings != NULL &&
+        cache->entropies != NULL)) && cache->scratch != NULL &&
+        cache->codes != NULL && cache->counts != NULL;
+}
+
+static void subset_cache_free(subset_cache *cache)
+{
+    if (cache->encodings != NULL || cache->entropies != NULL)
+    {
+        size_t const size = (size_t)1 << cache->l;
+        for (size_t mask = 0; cache->encodings && mask < size; ++mask)
+        {
+            free(cache->encodings[mask]);
+        }
+        for (size_t mask = 0; cache->entropies && mask < size; ++mask)
+        {
+            free(cache->entropies[mask]);
+        }
+    }
+    free(cache->encodings);
+    free(cache->entropies);
+    free(cache->scratch);
+    free(cache->codes);
+    free(cache->counts);
+}
+
+// The local entropy of the subset `mask` at each time step. A subset is
+// encoded by appending its lowest variable to the (memoised) encoding of the
+// rest, and relabelling the result with as few states as it takes.
+static double const *subset_entropy(subset_cache *cache, size_t mask,
+    inform_error *err)
+{
+    if (cache->entropies[mask] != NULL)
+    {
+        return cache->entropies[mask];
+    }
+
+    size_t const n = cache->n;
+    size_t v = 0;
+    while (!(mask & ((size_t)1 << v))) ++v;
+    size_t const rest = mask & (mask - 1);
+    int const *x = cache->series + n * v;
+
+    int *encoding = malloc(n * sizeof(int));
+    double *entropy = malloc(n * sizeof(double));
+    if (encoding == NULL || entropy == NULL)
+    {
+        free(entropy);
+        free(encoding);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    int states = 0;
+    if (rest == 0)
+    {
+        memcpy(encoding, x, n * sizeof(int));
+        states = cache->b[v];
+    }
+    else
+    {
+        if (subset_entropy(cache, rest, err) == NULL)
+        {
+            free(entropy);
+            free(encoding);
+            return NULL;
+        }
+        int const *prefix = cache->encodings[rest];
+        for (size_t t = 0; t < n; ++t)
+        {
+            cache->codes[t] = (uint64_t) prefix[t] * cache->b[v] + x[t];
+        }
+        states = inform_coalesce_codes(cache->codes, n, encoding, err);
+        if (inform_failed(err))
+        {
+            free(entropy);
+            free(encoding);
+            return NULL;
+        }
+    }
+
+    size_t *counts = cache->counts;
+    memset(counts, 0, states * sizeof(size_t));
+    for (size_t t = 0; t < n; ++t) counts[encoding[t]]++;
+    double const log_n = log2(n);
+    for (size_t t = 0; t < n; ++t)
+    {
+        entropy[t] = log_n - log2(counts[encoding[t]]);
+    }
+
+    cache->encodings[mask] = encoding;
+    cache->entropies[mask] = entropy;
+    return entropy;
+}
+
+// The local evidence of integration for a partitioning is the sum of the
+// local entropies of its parts less the local entropy of the whole.
+static bool subset_evidence(subset_cache *cache, size_t const *parts,
+    size_t nparts, size_t *masks, double *evidence, inform_error *err)
+{
+    size_t const n = cache->n;
+    memset(masks, 0, nparts * sizeof(size_t));
+    for (size_t i = 0; i < cache->l; ++i)
+    {
+        masks[parts[i]] |= (size_t)1 << i;
+    }
+
+    double const *whole = subset_entropy(cache, ((size_t)1 << cache->l) - 1,
+        err);
+    if (whole == NULL) return false;
+    for (size_t t = 0; t < n; ++t) evidence[t] = -whole[t];
+    for (size_t j = 0; j < nparts; ++j)
+    {
+        double const *h = subset_entropy(cache, masks[j], err);
+        if (h == NULL) return false;
+        for (size_t t = 0; t < n; ++t) evidence[t] += h[t];
+    }
+    return true;
+}
+
+// Fill the cache for every subset; each subset is derived from one with a
+// smaller bitmask, so a single ascending sweep suffices.
+static bool subset_cache_fill(subset_cache *cache, inform_error *err)
+{
+    size_t const size = (size_t)1 << cache->l;
+    for (size_t mask = 1; mask < size; ++mask)
+    {
+        if (subset_entropy(cache, mask, err) == NULL) return false;
+    }
+    return true;
+}
+
+static bool partition_evidence(subset_cache *cache, int const *series,
+    size_t l, size_t n, int const *b, size_t const *parts, size_t nparts,
+    size_t *masks, double *evidence, inform_error *err)
+{
+    if (cache->entropies != NULL)
+    {
+        return subset_evidence(cache, parts, nparts, masks, evidence, err);
+    }
+    inform_integration_evidence_part(series, l, n, b, parts, nparts, evidence,
+        err);
+    return inform_succeeded(err);
+}
+
+// Accumulate the extreme evidence over the partitionings with ranks in
+// [first, first + count). The range is split into contiguous shards, each of
+// which is unranked and then enumerated independently.
+static void evidence_range(subset_cache *cache, int const *series, size_t l,
+    size_t n, int const *b, uint64_t first, uint64_t count, bool parallel,
+    double *minimum, double *maximum, inform_error *err)
+{
+    uint64_t const nshards = (count + INTEGRATION_SHARD_SIZE - 1) /
+        INTEGRATION_SHARD_SIZE;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(parallel)
+#else
+    (void) parallel;
+#endif
+    for (uint64_t shard = 0; shard < nshards; ++shard)
+    {
+        inform_error shard_err = INFORM_SUCCESS;
+        uint64_t const start = first + shard * INTEGRATION_SHARD_SIZE;
+        uint64_t const stop = MIN(first + count, start + INTEGRATION_SHARD_SIZE);
+
+        size_t *xs = malloc(3 * l * sizeof(size_t));
+        double *lmi = malloc(3 * n * sizeof(double));
+        if (xs == NULL || lmi == NULL)
+        {
+            free(lmi);
+            free(xs);
+            INFORM_ERROR(&shard_err, INFORM_ENOMEM);
+        }
+        else
+        {
+            size_t *blocks = xs + l, *masks = blocks + l;
+            double *lo = lmi + n, *hi = lo + n;
+            for (size_t i = 0; i < n; ++i)
+            {
+                lo[i] = INFINITY;
+                hi[i] = -INFINITY;
+            }
+
+            size_t nparts = inform_unrank_partitioning(start, l, xs, blocks);
+            for (uint64_t rank = start; rank < stop; ++rank)
+            {
+                // the trivial partitioning carries no evidence
+                if (nparts > 1)
+                {
+                    if (!partition_evidence(cache, series, l, n, b, xs, nparts,
+                        masks, lmi, &shard_err))
+                    {
+                        break;
+                    }
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        lo[i] = MIN(lo[i], lmi[i]);
+                        hi[i] = MAX(hi[i], lmi[i]);
+                    }
+                }
+                nparts = inform_next_partitioning_blocks(xs, blocks, l);
+            }
+
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    minimum[i] = MIN(minimum[i], lo[i]);
+                    maximum[i] = MAX(maximum[i], hi[i]);
+                }
+            }
+            free(lmi);
+            free(xs);
+        }
+
+        if (inform_failed(&shard_err))
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            INFORM_ERROR(err, shard_err);
+        }
+    }
+}
+
 double *inform_integration_evidence(int const *series, size_t l, size_t n,
     int const *b, double *evidence, inform_error *err)
 {
@@ -28,6 +343,37 @@ double *inform_integration_evidence(int const *series, size_t l, size_t n,
     {
         return NULL;
     }
+    uint64_t const bell = inform_bell_number(l);
+    if (bell == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, NULL);
+    }
+    return inform_integration_evidence_range(series, l, n, b, 1, bell - 1,
+        evidence, err);
+}
+
+double *inform_integration_evidence_range(int const *series, size_t l,
+    size_t n, int const *b, uint64_t first, uint64_t count, double *evidence,
+    inform_error *err)
+{
+    if (check_arguments(series, l, err))
+    {
+        return NULL;
+    }
+    uint64_t const bell = inform_bell_number(l);
+    if (bell == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, NULL);
+    }
+    else if (count == 0 || first >= bell || count > bell - first)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+    bool const cached = cache_fits(l, n);
+    if (cached && check_states(series, l, n, b, err))
+    {
+        return NULL;
+    }
     int allocate = (evidence == NULL);
     if (allocate)
     {
@@ -37,9 +383,10 @@ double *inform_integration_evidence(int const *series, size_t l, size_t n,
             INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
         }
     }
-    double *lmi = malloc(n * sizeof(double));
-    if (lmi == NULL)
+    subset_cache cache = { 0 };
+    if (cached && !subset_cache_init(&cache, series, l, n, b, true))
     {
+        subset_cache_free(&cache);
         if (allocate) free(evidence);
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
@@ -51,24 +398,496 @@ double *inform_integration_evidence(int const *series, size_t l, size_t n,
         maximum[i] = -INFINITY;
     }
 
-    size_t *parts = inform_first_partitioning(l);
-    size_t nparts = 1;
-    while ((nparts = inform_next_partitioning(parts, l)))
+    // Shards may only share the cache once it is complete; a range with
+    // fewer partitionings than subsets fills it lazily in a single thread.
+    bool parallel = !cached;
+    if (cached && count >= ((uint64_t)1 << l))
     {
-        inform_integration_evidence_part(series, l, n, b, parts, nparts, lmi, err);
-        if (inform_failed(err))
+        parallel = subset_cache_fill(&cache, err);
+    }
+    if (inform_succeeded(err))
+    {
+        evidence_range(&cache, series, l, n, b, first, count, parallel,
+            minimum, maximum, err);
+    }
+    if (cached) subset_cache_free(&cache);
+
+    if (inform_failed(err))
+    {
+        if (allocate)
+        {
+            free(evidence);
+        }
+        return NULL;
+    }
+
+    return evidence;
+}
+
+// Add `sign` times the local entropy of the subset `mask` to `evidence`. The
+// entropies are memoised if the cache allows it; otherwise the subset is
+// encoded afresh.
+static bool add_entropy(subset_cache *cache, uint64_t mask, double sign,
+    double *evidence, inform_error *err)
+{
+    size_t const n = cache->n;
+    if (mask == 0)
+    {
+        return true;
+    }
+    else if (cache->entropies != NULL)
+    {
+        double const *h = subset_entropy(cache, (size_t) mask, err);
+        if (h == NULL) return false;
+        for (size_t t = 0; t < n; ++t) evidence[t] += sign * h[t];
+        return true;
+    }
+
+    int *encoding = cache->scratch;
+    int states = 0;
+    for (size_t v = 0; v < cache->l; ++v)
+    {
+        if (!(mask & ((uint64_t)1 << v))) continue;
+        int const *x = cache->series + n * v;
+        if (states == 0)
+        {
+            memcpy(encoding, x, n * sizeof(int));
+            states = cache->b[v];
+        }
+        else
+        {
+            for (size_t t = 0; t < n; ++t)
+            {
+                cache->codes[t] = (uint64_t) encoding[t] * cache->b[v] + x[t];
+            }
+            states = inform_coalesce_codes(cache->codes, n, encoding, err);
+            if (inform_failed(err)) return false;
+        }
+    }
+
+    size_t *counts = cache->counts;
+    memset(counts, 0, states * sizeof(size_t));
+    for (size_t t = 0; t < n; ++t) counts[encoding[t]]++;
+    double const log_n = log2(n);
+    for (size_t t = 0; t < n; ++t)
+    {
+        evidence[t] += sign * (log_n - log2(counts[encoding[t]]));
+    }
+    return true;
+}
+
+static void update_extremes(double const *lmi, size_t n, double *minimum,
+    double *maximum)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        minimum[i] = MIN(minimum[i], lmi[i]);
+        maximum[i] = MAX(maximum[i], lmi[i]);
+    }
+}
+
+static double mean(double const *xs, size_t n)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) sum += xs[i];
+    return sum / n;
+}
+
+static double wall_time(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static bool expired(double deadline)
+{
+    return deadline > 0.0 && wall_time() > deadline;
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double random_unit(uint64_t *state)
+{
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Every bipartition {A, B}, with the last variable always in B so that each
+// is visited once.
+static void bipartition_evidence(subset_cache *cache, double const *whole,
+    bool parallel, double deadline, double *minimum, double *maximum,
+    inform_error *err)
+{
+    size_t const l = cache->l, n = cache->n;
+    uint64_t const all = (l == 64) ? UINT64_MAX : ((uint64_t)1 << l) - 1;
+    uint64_t const count = ((uint64_t)1 << (l - 1)) - 1;
+    uint64_t const nshards = (count + INTEGRATION_SHARD_SIZE - 1) /
+        INTEGRATION_SHARD_SIZE;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) if(parallel)
+#else
+    (void) parallel;
+#endif
+    for (uint64_t shard = 0; shard < nshards; ++shard)
+    {
+        if (expired(deadline)) continue;
+
+        inform_error shard_err = INFORM_SUCCESS;
+        uint64_t const start = 1 + shard * INTEGRATION_SHARD_SIZE;
+        uint64_t const stop = MIN(count + 1, start + INTEGRATION_SHARD_SIZE);
+        double *lmi = malloc(3 * n * sizeof(double));
+        if (lmi == NULL)
+        {
+            INFORM_ERROR(&shard_err, INFORM_ENOMEM);
+        }
+        else
+        {
+            double *lo = lmi + n, *hi = lo + n;
+            for (size_t i = 0; i < n; ++i)
+            {
+                lo[i] = INFINITY;
+                hi[i] = -INFINITY;
+            }
+            for (uint64_t a = start; a < stop; ++a)
+            {
+                if ((a - start) % 64 == 63 && expired(deadline)) break;
+                for (size_t i = 0; i < n; ++i) lmi[i] = -whole[i];
+                if (!add_entropy(cache, a, 1.0, lmi, &shard_err) ||
+                    !add_entropy(cache, all & ~a, 1.0, lmi, &shard_err))
+                {
+                    break;
+                }
+                update_extremes(lmi, n, lo, hi);
+            }
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            {
+                update_extremes(lo, n, minimum, maximum);
+                update_extremes(hi, n, minimum, maximum);
+            }
+            free(lmi);
+        }
+
+        if (inform_failed(&shard_err))
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            INFORM_ERROR(err, shard_err);
+        }
+    }
+}
+
+/// the temperature, in bits, at the start and end of each annealing run
+#define INTEGRATION_INITIAL_TEMPERATURE 1.0
+#define INTEGRATION_FINAL_TEMPERATURE 1e-3
+
+// Simulated annealing for the partitioning with the least (sign = 1) or the
+// greatest (sign = -1) mean evidence. A move takes one variable to another
+// block or to a block of its own; every partitioning proposed along the way
+// contributes to the extremes.
+static bool anneal(subset_cache *cache, double const *whole, double sign,
+    size_t iterations, uint64_t *rng, double deadline, size_t *assign,
+    uint64_t *blocks, double *work, double *minimum, double *maximum,
+    inform_error *err)
+{
+    size_t const l = cache->l, n = cache->n;
+    double *current = work, *proposal = work + n;
+    size_t *candidates = assign + l;
+
+    // start from a random bipartition
+    memset(blocks, 0, l * sizeof(uint64_t));
+    for (size_t v = 0; v < l; ++v) assign[v] = next_random(rng) & 1;
+    size_t const u = next_random(rng) % l;
+    assign[u] = 0;
+    assign[(u + 1 + next_random(rng) % (l - 1)) % l] = 1;
+    for (size_t v = 0; v < l; ++v) blocks[assign[v]] |= (uint64_t)1 << v;
+    size_t nonempty = 2;
+
+    for (size_t i = 0; i < n; ++i) current[i] = -whole[i];
+    if (!add_entropy(cache, blocks[0], 1.0, current, err) ||
+        !add_entropy(cache, blocks[1], 1.0, current, err))
+    {
+        return false;
+    }
+    update_extremes(current, n, minimum, maximum);
+    double current_mean = mean(current, n);
+
+    for (size_t it = 0; it < iterations; ++it)
+    {
+        if (it % 64 == 0 && expired(deadline)) break;
+
+        size_t const v = next_random(rng) % l, src = assign[v];
+        uint64_t const bit = (uint64_t)1 << v;
+
+        // the destinations are the other blocks and one empty block
+        size_t ncandidates = 0;
+        bool empty = false;
+        for (size_t j = 0; j < l; ++j)
+        {
+            if (j == src) continue;
+            if (blocks[j] != 0 || !empty)
+            {
+                empty = empty || blocks[j] == 0;
+                candidates[ncandidates++] = j;
+            }
+        }
+        size_t const dst = candidates[next_random(rng) % ncandidates];
+        if (blocks[src] == bit && (blocks[dst] == 0 || nonempty == 2))
+        {
+            // the move would be trivial or leave a single block
+            continue;
+        }
+
+        memcpy(proposal, current, n * sizeof(double));
+        if (!add_entropy(cache, blocks[src], -1.0, proposal, err) ||
+            !add_entropy(cache, blocks[dst], -1.0, proposal, err) ||
+            !add_entropy(cache, blocks[src] & ~bit, 1.0, proposal, err) ||
+            !add_entropy(cache, blocks[dst] | bit, 1.0, proposal, err))
+        {
+            return false;
+        }
+        update_extremes(proposal, n, minimum, maximum);
+
+        double const proposal_mean = mean(proposal, n);
+        double const delta = sign * (proposal_mean - current_mean);
+        double const temperature = INTEGRATION_INITIAL_TEMPERATURE *
+            pow(INTEGRATION_FINAL_TEMPERATURE / INTEGRATION_INITIAL_TEMPERATURE,
+                (double) it / iterations);
+        if (delta <= 0.0 || random_unit(rng) < exp(-delta / temperature))
+        {
+            nonempty += (blocks[dst] == 0) - (blocks[src] == bit);
+            blocks[src] &= ~bit;
+            blocks[dst] |= bit;
+            assign[v] = dst;
+            double *swap = current;
+            current = proposal;
+            proposal = swap;
+            current_mean = proposal_mean;
+        }
+    }
+    return true;
+}
+
+typedef struct bound_search
+{
+    subset_cache *cache;
+    double const *whole;
+    uint64_t *blocks;
+    double *lower, *upper;
+    double *minimum, *maximum;
+    double deadline;
+    size_t nodes;
+    bool expired;
+} bound_search;
+
+// Depth-first search over the partitionings, assigning the variables in turn
+// to an existing block or a new one. Local entropies are monotone in the set
+// of variables (a joint state is never more frequent than its marginals), so
+// with the variables of `rest` still to be assigned the evidence of any
+// completion is bounded below by the entropies of the blocks so far, and
+// above by the entropies of each block joined with `rest` plus that of `rest`
+// for each new block it may form. A branch is pruned if it can improve
+// neither extreme at any time step.
+static bool branch(bound_search *search, size_t i, size_t k, inform_error *err)
+{
+    subset_cache *cache = search->cache;
+    size_t const l = cache->l, n = cache->n;
+    double *lower = search->lower, *upper = search->upper;
+
+    for (size_t t = 0; t < n; ++t) lower[t] = -search->whole[t];
+    for (size_t j = 0; j < k; ++j)
+    {
+        if (!add_entropy(cache, search->blocks[j], 1.0, lower, err))
+        {
+            return false;
+        }
+    }
+    if (i == l)
+    {
+        if (k > 1) update_extremes(lower, n, search->minimum, search->maximum);
+        return true;
+    }
+
+    if (++search->nodes % 1024 == 0 && expired(search->deadline))
+    {
+        search->expired = true;
+    }
+    if (search->expired)
+    {
+        return true;
+    }
+
+    bool prune = true;
+    for (size_t t = 0; t < n && prune; ++t)
+    {
+        prune = (lower[t] >= search->minimum[t]);
+    }
+    if (prune)
+    {
+        uint64_t const all = (l == 64) ? UINT64_MAX : ((uint64_t)1 << l) - 1;
+        uint64_t const rest = all & ~(((uint64_t)1 << i) - 1);
+        for (size_t t = 0; t < n; ++t) upper[t] = -search->whole[t];
+        for (size_t j = 0; j < k; ++j)
+        {
+            if (!add_entropy(cache, search->blocks[j] | rest, 1.0, upper, err))
+            {
+                return false;
+            }
+        }
+        if (!add_entropy(cache, rest, (double)(l - i), upper, err))
+        {
+            return false;
+        }
+        for (size_t t = 0; t < n && prune; ++t)
+        {
+            prune = (upper[t] <= search->maximum[t]);
+        }
+        if (prune) return true;
+    }
+
+    uint64_t const bit = (uint64_t)1 << i;
+    for (size_t j = 0; j <= k; ++j)
+    {
+        search->blocks[j] |= bit;
+        bool ok = branch(search, i + 1, (j == k) ? k + 1 : k, err);
+        search->blocks[j] &= ~bit;
+        if (!ok) return false;
+    }
+    return true;
+}
+
+static bool bounded_evidence(subset_cache *cache, double const *whole,
+    double deadline, uint64_t *blocks, double *work, double *minimum,
+    double *maximum, inform_error *err)
+{
+    size_t const l = cache->l, n = cache->n;
+
+    // the finest partitioning seeds the maximum
+    double *lmi = work;
+    for (size_t t = 0; t < n; ++t) lmi[t] = -whole[t];
+    for (size_t v = 0; v < l; ++v)
+    {
+        if (!add_entropy(cache, (uint64_t)1 << v, 1.0, lmi, err)) return false;
+    }
+    update_extremes(lmi, n, minimum, maximum);
+
+    bound_search search = { cache, whole, blocks, work, work + n, minimum,
+        maximum, deadline, 0, false };
+    memset(blocks, 0, l * sizeof(uint64_t));
+    blocks[0] = 1;
+    return branch(&search, 1, 1, err);
+}
+
+double *inform_integration_evidence_search(int const *series, size_t l,
+    size_t n, int const *b, inform_integration_search const *search,
+    double *evidence, inform_error *err)
+{
+    if (search == NULL || search->mode == INFORM_INTEGRATION_EXHAUSTIVE)
+    {
+        return inform_integration_evidence(series, l, n, b, evidence, err);
+    }
+    else if (check_arguments(series, l, err))
+    {
+        return NULL;
+    }
+    else if (l > 64)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, NULL);
+    }
+    else if (search->mode != INFORM_INTEGRATION_BIPARTITION &&
+        search->mode != INFORM_INTEGRATION_ANNEALED &&
+        search->mode != INFORM_INTEGRATION_BOUNDED)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+    else if (search->mode == INFORM_INTEGRATION_ANNEALED &&
+        search->iterations == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+    else if (check_states(series, l, n, b, err))
+    {
+        return NULL;
+    }
+
+    int allocate = (evidence == NULL);
+    if (allocate)
+    {
+        evidence = malloc(2 * n * sizeof(double));
+        if (evidence == NULL)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+    bool const memoise = cache_fits(l, n);
+    subset_cache cache = { 0 };
+    double *work = calloc(3 * n, sizeof(double));
+    size_t *assign = malloc(2 * l * sizeof(size_t));
+    uint64_t *blocks = malloc(l * sizeof(uint64_t));
+    if (!subset_cache_init(&cache, series, l, n, b, memoise) || work == NULL ||
+        assign == NULL || blocks == NULL)
+    {
+        free(blocks);
+        free(assign);
+        free(work);
+        subset_cache_free(&cache);
+        if (allocate) free(evidence);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    double *minimum = evidence;
+    double *maximum = minimum + n;
+    for (size_t i = 0; i < n; ++i)
+    {
+        minimum[i] = INFINITY;
+        maximum[i] = -INFINITY;
+    }
+
+    double const deadline = (search->seconds > 0.0) ?
+        wall_time() + search->seconds : 0.0;
+    double *whole = work + 2 * n;
+    uint64_t const all = (l == 64) ? UINT64_MAX : ((uint64_t)1 << l) - 1;
+    if (add_entropy(&cache, all, 1.0, whole, err))
+    {
+        if (search->mode == INFORM_INTEGRATION_BIPARTITION)
         {
-            break;
+            // every subset is a block of some bipartition
+            bool const parallel = memoise && subset_cache_fill(&cache, err);
+            if (inform_succeeded(err))
+            {
+                bipartition_evidence(&cache, whole, parallel, deadline,
+                    minimum, maximum, err);
+            }
         }
-        for (size_t i = 0; i < n; ++i)
+        else if (search->mode == INFORM_INTEGRATION_ANNEALED)
         {
-            minimum[i] = MIN(minimum[i], lmi[i]);
-            maximum[i] = MAX(maximum[i], lmi[i]);
+            uint64_t rng = search->seed;
+            if (anneal(&cache, whole, 1.0, search->iterations, &rng, deadline,
+                assign, blocks, work, minimum, maximum, err))
+            {
+                anneal(&cache, whole, -1.0, search->iterations, &rng, deadline,
+                    assign, blocks, work, minimum, maximum, err);
+            }
+        }
+        else
+        {
+            bounded_evidence(&cache, whole, deadline, blocks, work, minimum,
+                maximum, err);
         }
     }
-    free(parts);
-    free(lmi);
-    
+
+    free(blocks);
+    free(assign);
+    free(work);
+    subset_cache_free(&cache);
+
     if (inform_failed(err))
     {
         if (allocate)
@@ -3,6 +3,38 @@
 // license that can be found in the LICENSE file.
 #include <inform/mutual_info.h>
 #include <inform/shannon.h>
+#include <inform/utilities/counting.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MI_MAX_STATES (1ULL << 31)
+#define MI_TILE 16
+#define MI_SORT_FACTOR 16
+
+static bool check_states(int const *series, size_t l, size_t n, int const *b,
+    inform_error *err)
+{
+    for (size_t i = 0; i < l; ++i)
+    {
+        if (b[i] < 2)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+        }
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (series[j + n * i] < 0)
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+            }
+            else if (b[i] <= series[j + n * i])
+            {
+                INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+            }
+        }
+    }
+    return false;
+}
 
 static bool check_arguments(int const *series, size_t l, size_t n, int const *b,
     inform_error *err)
@@ -19,25 +51,86 @@ static bool check_arguments(int const *series, size_t l, size_t n, int const *b,
     {
         INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
     }
+    return check_states(series, l, n, b, err);
+}
+
+// Whether the joint support so far exceeds the number of observations that
+// the joint states are better counted by sorting them than with a histogram.
+static bool sort_joint_states(int const *b, size_t l, size_t n)
+{
+    double support = 1.0;
     for (size_t i = 0; i < l; ++i)
     {
-        if (b[i] < 2)
+        support *= b[i];
+    }
+    return support > MI_SORT_FACTOR * (double) n;
+}
+
+// The mutual information with the joint states counted by radix sorting
+// their 64-bit codes, so that the memory is linear in the number of
+// observations rather than in the joint support. The local mutual
+// information is stored in `mi` if it is not NULL.
+static double sorted_mutual_info(int const *series, size_t l, size_t n,
+    int const *b, double *mi, inform_error *err)
+{
+    double bits = 0.0;
+    size_t marginals_size = 0;
+    for (size_t i = 0; i < l; ++i)
+    {
+        bits += log2(b[i]);
+        marginals_size += b[i];
+    }
+    if (bits > 63.0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EENCODE, NAN);
+    }
+
+    uint64_t *codes = calloc(n, sizeof(uint64_t));
+    uint32_t *joint = malloc(n * sizeof(uint32_t));
+    uint32_t *marginals = calloc(marginals_size, sizeof(uint32_t));
+    if (codes == NULL || joint == NULL || marginals == NULL)
+    {
+        free(marginals);
+        free(joint);
+        free(codes);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+
+    for (size_t t = 0; t < n; ++t)
+    {
+        uint64_t code = 0;
+        for (size_t i = 0, offset = 0; i < l; offset += b[i++])
         {
-            INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+            int const x = series[t + n * i];
+            code = code * b[i] + x;
+            marginals[offset + x]++;
         }
-        for (size_t j = 0; j < n; ++j)
+        codes[t] = code;
+    }
+
+    double total = NAN;
+    inform_count_codes(codes, n, NULL, NULL, joint, err);
+    if (inform_succeeded(err))
+    {
+        double const norm = (l - 1) * log2((double) n);
+        total = 0.0;
+        for (size_t t = 0; t < n; ++t)
         {
-            if (series[j + n * i] < 0)
+            double local = log2(joint[t]) + norm;
+            for (size_t i = 0, offset = 0; i < l; offset += b[i++])
             {
-                INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
-            }
-            else if (b[i] <= series[j + n * i])
-            {
-                INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+                local -= log2(marginals[offset + series[t + n * i]]);
             }
+            if (mi != NULL) mi[t] = local;
+            total += local;
         }
+        total /= n;
     }
-    return false;
+
+    free(marginals);
+    free(joint);
+    free(codes);
+    return total;
 }
 
 inline static bool allocate(int const *b, size_t l, inform_dist **joint,
@@ -105,6 +198,11 @@ double inform_mutual_info(int const *series, size_t l, size_t n, int const *b,
 {
     if (check_arguments(series, l, n, b, err)) return NAN;
 
+    if (sort_joint_states(b, l, n))
+    {
+        return sorted_mutual_info(series, l, n, b, NULL, err);
+    }
+
     inform_dist **marginals = malloc(l * sizeof(inform_dist*));
     if (marginals == NULL)
     {
@@ -141,6 +239,17 @@ double *inform_local_mutual_info(int const *series, size_t l, size_t n,
         }
     }
 
+    if (sort_joint_states(b, l, n))
+    {
+        sorted_mutual_info(series, l, n, b, mi, err);
+        if (inform_failed(err))
+        {
+            if (allocate_mi) free(mi);
+            return NULL;
+        }
+        return mi;
+    }
+
     inform_dist **marginals = malloc(l * sizeof(inform_dist*));
     if (marginals == NULL)
     {
@@ -178,4 +287,469 @@ double *inform_local_mutual_info(int const *series, size_t l, size_t n,
     free_all(&joint, marginals, l);
 
     return mi;
-}
\ No newline at end of file
+}
+
+// The entropy of the joint states (x, y) whose codes are `x * b_y + y`, or of
+// the states `x` alone if `y` is NULL. Only the entries of `counts` which are
+// touched are read, and they are left zeroed.
+static double joint_entropy(int const *x, int const *y, int b_y, size_t n,
+    uint32_t *counts)
+{
+    for (size_t t = 0; t < n; ++t)
+    {
+        counts[(y == NULL) ? x[t] : x[t] * b_y + y[t]]++;
+    }
+    double sum = 0.0;
+    for (size_t t = 0; t < n; ++t)
+    {
+        size_t const state = (y == NULL) ? x[t] : x[t] * b_y + y[t];
+        double const c = counts[state];
+        if (c != 0)
+        {
+            sum += c * log2(c);
+            counts[state] = 0;
+        }
+    }
+    return log2((double) n) - sum / n;
+}
+
+double *inform_mutual_info_matrix(int const *series, size_t l, size_t n,
+    int const *b, int const *cond, size_t l_cond, int const *b_cond,
+    double *mi, inform_error *err)
+{
+    if (check_arguments(series, l, n, b, err))
+    {
+        return NULL;
+    }
+    else if (l_cond != 0 && (cond == NULL || b_cond == NULL))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    }
+    else if (l_cond != 0 && check_states(cond, l_cond, n, b_cond, err))
+    {
+        return NULL;
+    }
+
+    int max_b = 2;
+    for (size_t i = 0; i < l; ++i)
+    {
+        max_b = (max_b < b[i]) ? b[i] : max_b;
+    }
+    double z_states = 1.0;
+    for (size_t i = 0; i < l_cond; ++i)
+    {
+        z_states *= b_cond[i];
+    }
+    if (z_states * max_b * max_b > (double) MI_MAX_STATES)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t const b_z = (size_t) z_states;
+    size_t const scratch_size = max_b * b_z * max_b;
+
+    bool const allocate_mi = (mi == NULL);
+    if (allocate_mi)
+    {
+        mi = malloc(l * l * sizeof(double));
+    }
+    int *codes = malloc((l + 1) * n * sizeof(int));
+    double *h = malloc(l * sizeof(double));
+    uint32_t *counts = calloc(scratch_size, sizeof(uint32_t));
+    if (mi == NULL || codes == NULL || h == NULL || counts == NULL)
+    {
+        free(counts);
+        free(h);
+        free(codes);
+        if (allocate_mi) free(mi);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    // The conditions are encoded once, each variable is encoded together with
+    // them, and the entropies H(X, Z) of the variables and H(Z) are shared by
+    // all of the pairs.
+    int *z = codes + l * n;
+    for (size_t t = 0; t < n; ++t)
+    {
+        z[t] = 0;
+        for (size_t i = 0; i < l_cond; ++i)
+        {
+            z[t] = z[t] * b_cond[i] + cond[t + n * i];
+        }
+    }
+    for (size_t i = 0; i < l; ++i)
+    {
+        for (size_t t = 0; t < n; ++t)
+        {
+            codes[t + n * i] = series[t + n * i] * (int) b_z + z[t];
+        }
+    }
+    double const h_z = joint_entropy(z, NULL, 0, n, counts);
+    for (size_t i = 0; i < l; ++i)
+    {
+        h[i] = joint_entropy(codes + n * i, NULL, 0, n, counts);
+        mi[i * l + i] = h[i] - h_z;
+    }
+    free(counts);
+
+    // The pairs are visited in square tiles of the upper triangle, so that
+    // the columns of a tile stay in cache while each is paired with the
+    // others.
+    size_t const tiles = (l + MI_TILE - 1) / MI_TILE;
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *scratch = calloc(scratch_size, sizeof(uint32_t));
+        if (scratch == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (size_t tile = 0; tile < tiles * tiles; ++tile)
+        {
+            size_t const ti = tile / tiles, tj = tile % tiles;
+            if (scratch == NULL || tj < ti) continue;
+            size_t const i_end = ((ti + 1) * MI_TILE < l) ?
+                (ti + 1) * MI_TILE : l;
+            size_t const j_end = ((tj + 1) * MI_TILE < l) ?
+                (tj + 1) * MI_TILE : l;
+            for (size_t i = ti * MI_TILE; i < i_end; ++i)
+            {
+                size_t const j_begin = (ti == tj) ? i + 1 : tj * MI_TILE;
+                for (size_t j = j_begin; j < j_end; ++j)
+                {
+                    double const h_xyz = joint_entropy(codes + n * i,
+                        series + n * j, b[j], n, scratch);
+                    mi[i * l + j] = mi[j * l + i] = h[i] + h[j] - h_xyz - h_z;
+                }
+            }
+        }
+        free(scratch);
+    }
+
+    free(h);
+    free(codes);
+
+    if (failed)
+    {
+        if (allocate_mi) free(mi);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return mi;
+}
+
+// The mutual information between the earlier states of `xs` and the states
+// of `ys` `lag` steps later, with the marginals taken as the row and column
+// sums of the joint histogram.
+// The mutual information of one lag from its joint histogram, with the
+// marginals taken as its row and column sums.
+static double lagged_mutual_info(uint32_t const *joint, size_t bx, size_t by,
+    double N, uint32_t *px, uint32_t *py)
+{
+    memset(px, 0, bx * sizeof(uint32_t));
+    memset(py, 0, by * sizeof(uint32_t));
+    for (size_t a = 0; a < bx; ++a)
+    {
+        for (size_t c = 0; c < by; ++c)
+        {
+            px[a] += joint[a * by + c];
+            py[c] += joint[a * by + c];
+        }
+    }
+
+    double mi = 0.0;
+    for (size_t a = 0; a < bx; ++a)
+    {
+        for (size_t c = 0; c < by; ++c)
+        {
+            double const j = joint[a * by + c];
+            if (j != 0)
+            {
+                mi += j * log2((j * N) / ((double) px[a] * py[c]));
+            }
+        }
+    }
+    return mi / N;
+}
+
+double *inform_lagged_mutual_info(int const *xs, int const *ys, size_t n,
+    size_t m, int bx, int by, size_t max_lag, double *mi, inform_error *err)
+{
+    if (xs == NULL || ys == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, NULL);
+    }
+    else if (m < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NULL);
+    }
+    else if (m <= max_lag)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, NULL);
+    }
+    else if (check_states(xs, 1, n * m, &bx, err) ||
+        check_states(ys, 1, n * m, &by, err))
+    {
+        return NULL;
+    }
+    else if ((double) bx * by * (max_lag + 1) > (double) MI_MAX_STATES)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t const lags = max_lag + 1;
+    size_t const joint_size = (size_t) bx * by;
+    size_t const size = lags * joint_size;
+
+    bool const allocate_mi = (mi == NULL);
+    if (allocate_mi)
+    {
+        mi = malloc(lags * sizeof(double));
+    }
+    uint32_t *joints = calloc(size, sizeof(uint32_t));
+    if (mi == NULL || joints == NULL)
+    {
+        free(joints);
+        if (allocate_mi) free(mi);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    // A single scan over the observations: each state of `xs` is paired with
+    // the states of `ys` at every lag, so the histograms of all of the lags
+    // are built together. The observations are split into blocks, each thread
+    // accumulating its own histograms which are then summed.
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *local = calloc(size, sizeof(uint32_t));
+        if (local == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (size_t p = 0; p < n * m; ++p)
+        {
+            if (local == NULL) continue;
+            size_t const t = p % m;
+            size_t const last = (m - 1 - t < max_lag) ? m - 1 - t : max_lag;
+            uint32_t *row = local + (size_t) xs[p] * by;
+            int const *y = ys + p;
+            for (size_t lag = 0; lag <= last; ++lag, row += joint_size)
+            {
+                row[y[lag]]++;
+            }
+        }
+        if (local != NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            for (size_t s = 0; s < size; ++s)
+            {
+                joints[s] += local[s];
+            }
+        }
+        free(local);
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *marginals = malloc((bx + by) * sizeof(uint32_t));
+        if (marginals == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (size_t lag = 0; lag < lags; ++lag)
+        {
+            if (marginals == NULL) continue;
+            mi[lag] = lagged_mutual_info(joints + lag * joint_size, bx, by,
+                (double) n * (m - lag), marginals, marginals + bx);
+        }
+        free(marginals);
+    }
+    free(joints);
+
+    if (failed)
+    {
+        if (allocate_mi) free(mi);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return mi;
+}
+
+// The entropy of `n` states given by their codes, from a histogram whose
+// touched entries are left zeroed.
+static double ensemble_entropy(uint64_t const *codes, size_t n,
+    uint32_t *counts)
+{
+    for (size_t r = 0; r < n; ++r)
+    {
+        counts[codes[r]]++;
+    }
+    double sum = 0.0;
+    for (size_t r = 0; r < n; ++r)
+    {
+        double const c = counts[codes[r]];
+        if (c != 0)
+        {
+            sum += c * log2(c);
+            counts[codes[r]] = 0;
+        }
+    }
+    return log2((double) n) - sum / n;
+}
+
+double *inform_mutual_info_ensemble(int const *series, size_t l, size_t n,
+    size_t m, int const *b, double *mi, inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    }
+    else if (l < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, NULL);
+    }
+    else if (m < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NULL);
+    }
+    else if (check_states(series, l, n * m, b, err))
+    {
+        return NULL;
+    }
+
+    double bits = 0.0;
+    size_t max_b = 0;
+    for (size_t i = 0; i < l; ++i)
+    {
+        bits += log2(b[i]);
+        max_b = ((size_t) b[i] > max_b) ? (size_t) b[i] : max_b;
+    }
+    if (bits > 63.0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EENCODE, NULL);
+    }
+    // the joint states are counted by sorting when their support is large
+    bool const sorted = sort_joint_states(b, l, n);
+    size_t joint_size = n;
+    if (!sorted)
+    {
+        joint_size = 1;
+        for (size_t i = 0; i < l; ++i)
+        {
+            joint_size *= b[i];
+        }
+    }
+    size_t const counts_size = (joint_size > max_b) ? joint_size : max_b;
+
+    bool const allocate_mi = (mi == NULL);
+    if (allocate_mi)
+    {
+        mi = malloc(m * sizeof(double));
+        if (mi == NULL)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        // the codes and joint codes, followed by the sorting scratch space
+        uint64_t *codes = malloc((sorted ? 4 : 2) * n * sizeof(uint64_t));
+        uint32_t *counts = calloc(counts_size, sizeof(uint32_t));
+        bool const ready = (codes != NULL && counts != NULL);
+        if (!ready)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (size_t t = 0; t < m; ++t)
+        {
+            if (!ready) continue;
+            uint64_t *joint = codes + n;
+            double value = 0.0;
+            memset(joint, 0, n * sizeof(uint64_t));
+            for (size_t i = 0; i < l; ++i)
+            {
+                int const *x = series + i * n * m + t;
+                for (size_t r = 0; r < n; ++r)
+                {
+                    codes[r] = (uint64_t) x[r * m];
+                    joint[r] = joint[r] * b[i] + codes[r];
+                }
+                value += ensemble_entropy(codes, n, counts);
+            }
+            if (sorted)
+            {
+                inform_error sort_err = INFORM_SUCCESS;
+                size_t const distinct = inform_count_codes_buffered(joint,
+                    n, NULL, counts, NULL, joint + n, NULL, &sort_err);
+                double sum = 0.0;
+                for (size_t s = 0; s < distinct; ++s)
+                {
+                    sum += counts[s] * log2(counts[s]);
+                    counts[s] = 0;
+                }
+                value -= log2((double) n) - sum / n;
+                if (inform_failed(&sort_err))
+                {
+#ifdef _OPENMP
+                    #pragma omp critical
+#endif
+                    failed = true;
+                }
+            }
+            else
+            {
+                value -= ensemble_entropy(joint, n, counts);
+            }
+            mi[t] = value;
+        }
+        free(counts);
+        free(codes);
+    }
+
+    if (failed)
+    {
+        if (allocate_mi) free(mi);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return mi;
+}
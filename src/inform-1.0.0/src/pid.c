@@ -1,603 +1,414 @@
 // Copyright 2016-2017 ELIFE. All rights reserved.
 // Use of this source code is governed by a MIT
 // license that can be found in the LICENSE file.
-#include <ginger/vector.h>
 #include <inform/pid.h>
-#include <inform/dist.h>
 #include <inform/utilities.h>
-#include <inform/utilities/black_boxing.h>
-#include <inform/utilities/encoding.h>
 #include <string.h>
 #include <math.h>
 
-#define FAILED(ERR) ((ERR) && *(ERR) != INFORM_SUCCESS)
-
-#define MAKE_PUSH(NAME, TYPE) \
-static TYPE* NAME(TYPE* xs, TYPE x) \
-{ \
-    if (!xs) \
-    { \
-        return xs; \
-    } \
-     \
-    size_t cap = gvector_cap(xs); \
-    if (gvector_len(xs) >= cap) \
-    { \
-        cap = (cap) ? 2*cap : 1; \
-        TYPE* ys = gvector_reserve(xs, cap); \
-        if (!ys) \
-        { \
-            return NULL; \
-        } \
-        xs = ys; \
-    } \
-    xs[gvector_len(xs)++] = x; \
-    return xs; \
-}
+/// the largest number of sources whose lattice can be built
+#define PID_MAX_SOURCES 5
+
+// The structure of the redundancy lattice over `l` sources. An antichain is
+// a bitmask over the nonempty subsets of the sources, with bit `s - 1` set if
+// the subset with bitmask `s` is a member.
+typedef struct pid_hasse
+{
+    size_t l, size;
+    size_t *names, *name_offsets;
+    size_t *below, *below_offsets;
+    size_t *above, *above_offsets;
+} pid_hasse;
 
-MAKE_PUSH(push_value, size_t)
-MAKE_PUSH(push_source, inform_pid_source*)
+static pid_hasse *hasse_cache[PID_MAX_SOURCES + 1];
 
-static void free_source(inform_pid_source *src)
+typedef struct antichain
 {
-    if (src)
-    {
-        gvector_free(src->name);
-        gvector_free(src->above);
-        gvector_free(src->below);
-        free(src);
-    }
-}
+    uint64_t members;
+    // the subsets which contain some member
+    uint64_t upset;
+    size_t height;
+} antichain;
 
-static void free_all_sources(inform_pid_source **srcs)
+static void free_hasse(pid_hasse *hasse)
 {
-    if (srcs)
+    if (hasse)
     {
-        for (size_t i = 0; i < gvector_len(srcs); ++i)
-        {
-            free_source(srcs[i]);
-        }
-        gvector_free(srcs);
+        free(hasse->names);
+        free(hasse->name_offsets);
+        free(hasse->below);
+        free(hasse->below_offsets);
+        free(hasse->above);
+        free(hasse->above_offsets);
+        free(hasse);
     }
 }
 
-static inform_pid_source *alloc_source(size_t *name,
-        inform_error *err)
+// Enumerate the antichains by deciding, for each subset in turn, whether it
+// joins the antichain; a subset may only join if it is incomparable to each
+// member so far.
+static size_t antichains(size_t s, size_t m, uint64_t members,
+    uint64_t const *comparable, antichain *chains, size_t size)
 {
-    if (!name)
-    {
-        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
-    }
-
-    inform_pid_source *src = malloc(sizeof(inform_pid_source));
-    if (!src)
+    if (s > m)
     {
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-
-    src->name = NULL;
-    src->above = src->below = NULL;
-
-    size_t *local_name = gvector_dup(name);
-    if (!local_name)
-    {
-        free_source(src);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-    src->name = local_name;
-
-    local_name = gvector_shrink(src->name);
-    if (!local_name)
-    {
-        free_source(src);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        if (members != 0)
+        {
+            if (chains) chains[size].members = members;
+            size += 1;
+        }
+        return size;
     }
-    src->name = local_name;
-    src->size = gvector_len(src->name);
-
-    src->above = gvector_alloc(0, 0, sizeof(inform_pid_source*));
-    if (!src->above)
+    uint64_t const bit = (uint64_t)1 << (s - 1);
+    size = antichains(s + 1, m, members, comparable, chains, size);
+    if ((members & comparable[s]) == 0)
     {
-        free_source(src);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        size = antichains(s + 1, m, members | bit, comparable, chains, size);
     }
-    src->n_above = 0;
+    return size;
+}
 
-    src->below = gvector_alloc(0, 0, sizeof(inform_pid_source*));
-    if (!src->below)
+// Order the antichains from the bottom of the lattice up: if a < b, then the
+// upset of b is strictly contained in that of a.
+static int compare_antichains(void const *x, void const *y)
+{
+    antichain const *a = x, *b = y;
+    if (a->height != b->height)
     {
-        free_source(src);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        return (a->height < b->height) - (a->height > b->height);
     }
-    src->n_below = 0;
-
-    src->imin = src->pi = 0.0;
+    return (a->members > b->members) - (a->members < b->members);
+}
 
-    return src;
+// a <= b if every member of b contains some member of a
+inline static bool antichain_below(antichain const *a, antichain const *b)
+{
+    return (b->upset & ~a->upset) == 0;
 }
 
-static inform_pid_source **sources_rec(size_t i, size_t m, size_t *c,
-        inform_pid_source **srcs, inform_error *err)
+static size_t *edges_csr(size_t const *from, size_t const *to, size_t n,
+    size_t size, size_t **offsets)
 {
-    if (!c || !srcs)
+    size_t *off = calloc(size + 1, sizeof(size_t));
+    size_t *edges = malloc((n ? n : 1) * sizeof(size_t));
+    if (off == NULL || edges == NULL)
     {
-        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+        free(edges);
+        free(off);
+        return NULL;
     }
+    for (size_t e = 0; e < n; ++e) off[from[e] + 1]++;
+    for (size_t i = 0; i < size; ++i) off[i + 1] += off[i];
+    for (size_t e = 0; e < n; ++e) edges[off[from[e]]++] = to[e];
+    for (size_t i = size; i > 0; --i) off[i] = off[i - 1];
+    off[0] = 0;
+    *offsets = off;
+    return edges;
+}
 
-    if (i < m)
-    {
-        size_t *d = gvector_dup(c);
-        if (!d)
-        {
-            gvector_free(c);
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, srcs);
-        }
-        srcs = sources_rec(i + 1, m, d, srcs, err);
-        if (FAILED(err))
-        {
-            gvector_free(c);
-            return srcs;
-        }
-    }
+static pid_hasse *build_hasse(size_t l, inform_error *err)
+{
+    size_t const m = ((size_t)1 << l) - 1;
 
-    if (i <= m)
+    uint64_t comparable[64] = { 0 }, supersets[64] = { 0 };
+    for (size_t s = 1; s <= m; ++s)
     {
-        size_t z = 0;
-        for (size_t j = 0; j < gvector_len(c); ++j)
+        for (size_t t = 1; t <= m; ++t)
         {
-            z = i & c[j];
-            if (z == i || z == c[j])
+            if ((s & t) == s) supersets[s] |= (uint64_t)1 << (t - 1);
+            if ((s & t) == s || (s & t) == t)
             {
-                gvector_free(c);
-                return srcs;
+                comparable[s] |= (uint64_t)1 << (t - 1);
             }
         }
-
-        size_t *d = push_value(c, i);
-        if (!d)
-        {
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, srcs);
-        }
-        c = d;
-
-        inform_pid_source *src = alloc_source(c, err);
-        if (FAILED(err))
-        {
-            gvector_free(c);
-            return srcs;
-        }
-
-        inform_pid_source **ts = push_source(srcs, src);
-        if (!ts)
-        {
-            free_source(src);
-            gvector_free(c);
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, srcs);
-        }
-        srcs = ts;
-
-        return sources_rec(i + 1, m, c, srcs, err);
-    }
-    else
-    {
-        gvector_free(c);
     }
 
-    return srcs;
-}
-
-static inform_pid_source **sources(size_t n, inform_error *err)
-{
-    if (n < 1)
-    {
-        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
-    }
-    size_t const m = (1 << n) - 1;
-    inform_pid_source **srcs = gvector_alloc(0, 0, sizeof(inform_pid_source*));
-    if (!srcs)
+    size_t const size = antichains(1, m, 0, comparable, NULL, 0);
+    antichain *chains = malloc(size * sizeof(antichain));
+    pid_hasse *hasse = calloc(1, sizeof(pid_hasse));
+    if (chains == NULL || hasse == NULL)
     {
+        free(hasse);
+        free(chains);
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
-    for (size_t i = 1; i <= m; ++i)
+    antichains(1, m, 0, comparable, chains, 0);
+    size_t nnames = 0;
+    for (size_t i = 0; i < size; ++i)
     {
-        size_t *c = gvector_alloc(1, 1, sizeof(size_t));
-        if (!c)
-        {
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-        }
-        c[0] = i;
-
-        inform_pid_source *src = alloc_source(c, err);
-        if (FAILED(err))
-        {
-            gvector_free(c);
-            return NULL;
-        }
-
-        inform_pid_source **ts = push_source(srcs, src);
-        if (!ts)
+        chains[i].upset = 0;
+        for (size_t s = 1; s <= m; ++s)
         {
-            free_source(src);
-            free_all_sources(srcs);
-            gvector_free(c);
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+            if (chains[i].members & ((uint64_t)1 << (s - 1)))
+            {
+                chains[i].upset |= supersets[s];
+                nnames += 1;
+            }
         }
-        srcs = ts;
-
-        srcs = sources_rec(i + 1, m, c, srcs, err);
-        if (FAILED(err))
+        chains[i].height = 0;
+        for (uint64_t u = chains[i].upset; u; u &= u - 1)
         {
-            free_all_sources(srcs);
-            return NULL;
+            chains[i].height += 1;
         }
     }
+    qsort(chains, size, sizeof(antichain), compare_antichains);
 
-    inform_pid_source **ts = gvector_shrink(srcs);
-    if (!ts)
+    hasse->l = l;
+    hasse->size = size;
+    hasse->names = malloc(nnames * sizeof(size_t));
+    hasse->name_offsets = malloc((size + 1) * sizeof(size_t));
+    if (hasse->names == NULL || hasse->name_offsets == NULL)
     {
-        free_all_sources(srcs);
+        free(chains);
+        free_hasse(hasse);
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
-    return ts;
-}
-
-static bool name_below(size_t const *xs, size_t const *ys)
-{
-    size_t const m = gvector_len(xs);
-    size_t const n = gvector_len(ys);
-
-    bool is_below = true;
-    for (size_t const *y = ys; y < ys + n && is_below; ++y)
+    hasse->name_offsets[0] = 0;
+    for (size_t i = 0, k = 0; i < size; ++i)
     {
-        bool is_valid = false;
-        for (size_t const *x = xs; x < xs + m && !is_valid; ++x)
+        for (size_t s = 1; s <= m; ++s)
         {
-            if ((*x & *y) == *x)
+            if (chains[i].members & ((uint64_t)1 << (s - 1)))
             {
-                is_valid = true;
+                hasse->names[k++] = s;
             }
         }
-        if (!is_valid)
-        {
-            is_below = false;
-        }
+        hasse->name_offsets[i + 1] = k;
     }
-    return is_below;
-}
 
-static bool below(inform_pid_source const *a, inform_pid_source const *b)
-{
-    return name_below(a->name, b->name);
-}
-
-static void toposort(inform_pid_source **srcs, inform_error *err)
-{
-    if (!srcs)
-    {
-        INFORM_ERROR_RETURN_VOID(err, INFORM_EARG);
-    }
-    size_t const n = gvector_len(srcs);
-    size_t u = 0, v = 0;
-    while (v < n - 1)
+    // b covers a if a < b with nothing in between; the nodes are in
+    // topological order, so anything in between precedes b, and is above
+    // one of the covers of a that have already been found.
+    size_t capacity = 4 * size, nedges = 0;
+    size_t *lower = malloc(capacity * sizeof(size_t));
+    size_t *upper = malloc(capacity * sizeof(size_t));
+    bool failed = (lower == NULL || upper == NULL);
+    for (size_t i = 0; i < size && !failed; ++i)
     {
-        u = v;
-        for (size_t i = u; i < n; ++i)
+        size_t const first = nedges;
+        for (size_t j = i + 1; j < size && !failed; ++j)
         {
-            bool is_bottom = true;
-            for (size_t j = u; j < n; ++j)
+            if (!antichain_below(chains + i, chains + j)) continue;
+            bool covers = true;
+            for (size_t e = first; e < nedges && covers; ++e)
+            {
+                covers = !antichain_below(chains + upper[e], chains + j);
+            }
+            if (!covers) continue;
+            if (nedges == capacity)
             {
-                if (i != j && below(srcs[j], srcs[i]))
+                capacity *= 2;
+                size_t *x = realloc(lower, capacity * sizeof(size_t));
+                if (x) lower = x;
+                size_t *y = realloc(upper, capacity * sizeof(size_t));
+                if (y) upper = y;
+                if (x == NULL || y == NULL)
                 {
-                    is_bottom = false;
+                    failed = true;
                     break;
                 }
             }
-            if (is_bottom)
-            {
-                inform_pid_source *tmp = srcs[v];
-                srcs[v] = srcs[i];
-                srcs[i] = tmp;
-                v += 1;
-            }
+            lower[nedges] = i;
+            upper[nedges] = j;
+            nedges += 1;
         }
     }
-}
-
-static inform_pid_lattice *inform_pid_lattice_alloc(inform_error *err)
-{
-    inform_pid_lattice *lattice = malloc(sizeof(inform_pid_lattice));
-    if (!lattice)
+    free(chains);
+    if (!failed)
     {
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        hasse->below = edges_csr(upper, lower, nedges, size,
+            &hasse->below_offsets);
+        hasse->above = edges_csr(lower, upper, nedges, size,
+            &hasse->above_offsets);
+        failed = (hasse->below == NULL || hasse->above == NULL);
     }
-
-    lattice->sources = NULL;
-    lattice->top = NULL;
-    lattice->bottom = NULL;
-
-    return lattice;
-}
-
-void inform_pid_lattice_free(inform_pid_lattice *lattice)
-{
-    if (lattice)
+    free(upper);
+    free(lower);
+    if (failed)
     {
-        free_all_sources(lattice->sources);
-
-        lattice->sources = NULL;
-        lattice->top = NULL;
-        lattice->bottom = NULL;
-
-        free(lattice);
+        free_hasse(hasse);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
+    return hasse;
 }
 
-static inform_pid_lattice *build_hasse(inform_pid_source **srcs,
-        inform_error *err)
+// The lattices are built once per number of sources and shared by every
+// decomposition for the life of the process.
+static pid_hasse const *hasse(size_t l, inform_error *err)
 {
-    if (!srcs)
+    if (l > PID_MAX_SOURCES)
     {
-        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, NULL);
     }
-
-    size_t const n = gvector_len(srcs);
-    if (n == 0)
-    {
-        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
-    }
-
-    inform_pid_lattice *lattice = inform_pid_lattice_alloc(err);
-    if (FAILED(err))
+    pid_hasse *h = NULL;
+#ifdef _OPENMP
+    #pragma omp critical (inform_pid_hasse)
+#endif
     {
-        return NULL;
-    }
-
-    for (size_t i = 0; i < n; ++i)
-    {
-        for (size_t j = i + 1; j < n; ++j)
+        if (hasse_cache[l] == NULL)
         {
-            if (below(srcs[i], srcs[j]))
-            {
-                bool stop = false;
-                for (size_t k = 0; k < gvector_len(srcs[i]->above); ++k)
-                {
-                    inform_pid_source *x = srcs[i]->above[k];
-                    if (below(x, srcs[j]))
-                    {
-                        stop = true;
-                        break;
-                    }
-                }
-                if (stop)
-                {
-                    break;
-                }
-                else
-                {
-                    inform_pid_source **above, **below;
-
-                    above = push_source(srcs[i]->above, srcs[j]);
-                    if (!above)
-                    {
-                        free_all_sources(srcs);
-                        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-                    }
-                    srcs[i]->above = above;
-                    srcs[i]->n_above++;
-
-                    below = push_source(srcs[j]->below, srcs[i]);
-                    if (!below)
-                    {
-                        free_all_sources(srcs);
-                        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-                    }
-                    srcs[j]->below = below;
-                    srcs[j]->n_below++;
-                }
-            }
+            hasse_cache[l] = build_hasse(l, err);
         }
+        h = hasse_cache[l];
     }
-
-    lattice->sources = srcs;
-    lattice->bottom = srcs[0];
-    lattice->top = srcs[n-1];
-    lattice->size = gvector_len(lattice->sources);
-
-    return lattice;
+    return h;
 }
 
-static inform_pid_lattice *hasse(size_t n, inform_error *err)
+void inform_pid_lattice_free(inform_pid_lattice *lattice)
 {
-    inform_pid_source **srcs = sources(n, err);
-    if (FAILED(err))
+    if (lattice)
     {
-        return NULL;
+        free(lattice->imin);
+        free(lattice->pi);
+        free(lattice);
     }
+}
 
-    toposort(srcs, err);
-    if (FAILED(err))
+inform_pid_lattice *inform_pid_lattice_alloc(size_t l, inform_error *err)
+{
+    pid_hasse const *h = hasse(l, err);
+    if (h == NULL)
     {
         return NULL;
     }
 
-    inform_pid_lattice *lattice = build_hasse(srcs, err);
-    if (FAILED(err))
+    inform_pid_lattice *lattice = malloc(sizeof(inform_pid_lattice));
+    if (!lattice)
     {
-        return NULL;
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    lattice->l = l;
+    lattice->size = h->size;
+    lattice->names = h->names;
+    lattice->name_offsets = h->name_offsets;
+    lattice->below = h->below;
+    lattice->below_offsets = h->below_offsets;
+    lattice->above = h->above;
+    lattice->above_offsets = h->above_offsets;
+    lattice->bottom = 0;
+    lattice->top = h->size - 1;
+    lattice->imin = calloc(h->size, sizeof(double));
+    lattice->pi = calloc(h->size, sizeof(double));
+    if (!lattice->imin || !lattice->pi)
+    {
+        inform_pid_lattice_free(lattice);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
     return lattice;
 }
 
-static size_t **subsets(size_t n, inform_error *err)
+// The specific information that each nonempty subset of the responses
+// provides about each stimulus, in a table with a row of `bs` values for each
+// subset (indexed by its bitmask less one). The responses of a subset are
+// encoded once, by appending its lowest response to the encoding of the rest
+// and relabelling the result densely, and every antichain is then evaluated
+// from the table.
+static double *specific_info(int const *stimulus, int const *responses,
+    size_t l, size_t n, int bs, int const *br, uint32_t const *s_hist,
+    inform_error *err)
 {
-    if (n < 1)
-    {
-        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
-    }
-    size_t m = 1 << n;
-    size_t **ss = gvector_alloc(m - 1, m - 1, sizeof(size_t*));
-    memset(ss, 0, sizeof(size_t*)*gvector_len(ss));
-    if (!ss)
-    {
+    size_t const m = ((size_t)1 << l) - 1;
+    int maxb = 0;
+    for (size_t i = 0; i < l; ++i) maxb = MAX(maxb, br[i]);
+    size_t const states = MAX(n, (size_t) maxb);
+
+    double *si = malloc(m * bs * sizeof(double));
+    int *encodings = malloc(m * n * sizeof(int));
+    uint64_t *codes = malloc(n * sizeof(uint64_t));
+    uint32_t *r_hist = malloc(states * sizeof(uint32_t));
+    uint32_t *j_hist = malloc(states * bs * sizeof(uint32_t));
+    int *nstates = malloc(m * sizeof(int));
+    if (!si || !encodings || !codes || !r_hist || !j_hist || !nstates)
+    {
+        free(nstates);
+        free(j_hist);
+        free(r_hist);
+        free(codes);
+        free(encodings);
+        free(si);
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
-    for (size_t i = 1; i < m; ++i)
+
+    for (size_t mask = 1; mask <= m && inform_succeeded(err); ++mask)
     {
-        size_t *s = gvector_alloc(n, 0, sizeof(size_t));
-        if (!s)
+        size_t v = 0;
+        while (!(mask & ((size_t)1 << v))) ++v;
+        size_t const rest = mask & (mask - 1);
+        int const *x = responses + v * n;
+        int *encoding = encodings + (mask - 1) * n;
+        if (rest == 0)
         {
-            for (size_t j = 0; j < gvector_len(ss); ++j)
-            {
-                gvector_free(ss[j]);
-            }
-            gvector_free(ss);
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-        }
-        for (size_t j = 0; j < n; ++j)
-        {
-            if ((i & (1 << j)) != 0)
-            {
-                size_t *t = push_value(s,j);
-                if (!t)
-                {
-                    gvector_free(s);
-                    for (size_t k = 0; k < gvector_len(ss); ++k)
-                    {
-                        gvector_free(ss[k]);
-                    }
-                    gvector_free(ss);
-                    INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-                }
-                s = t;
-            }
+            memcpy(encoding, x, n * sizeof(int));
+            nstates[mask - 1] = br[v];
         }
-        size_t *t = gvector_shrink(s);
-        if (!t)
+        else
         {
-            gvector_free(s);
-            for (size_t j = 0; j < gvector_len(ss); ++j)
+            int const *prefix = encodings + (rest - 1) * n;
+            for (size_t t = 0; t < n; ++t)
             {
-                gvector_free(ss[j]);
+                codes[t] = (uint64_t) prefix[t] * br[v] + x[t];
             }
-            gvector_free(ss);
-            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+            nstates[mask - 1] = inform_coalesce_codes(codes, n, encoding, err);
+            if (inform_failed(err)) break;
         }
-        s = t;
-        ss[i-1] = s;
-    }
-    return ss;
-}
-
-static double *specific_info(int const *stimulus, int const *responses,
-        size_t l, size_t n, int bs, int const *br, size_t const *source,
-        inform_dist const *s_dist, inform_error *err)
-{
-    size_t const u = gvector_len(source);
-
-    int *box = gvector_alloc((u + 1) * n, (u + 1) * n, sizeof(int));
-    if (box == NULL)
-    {
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-    for (size_t i = 0; i < u; ++i)
-    {
-        memcpy(box + i*n, responses + source[i]*n, n*sizeof(int));
-    }
-    inform_black_box(box, u, 1, n, br, NULL, NULL, box + u*n, err);
-    if (inform_failed(err))
-    {
-        gvector_free(box);
-        return NULL;
-    }
-    responses = box + u*n;
-    int b = 1;
-    for (size_t i = 0; i < u; ++i) b *= br[source[i]];
-
-    size_t const j_size = bs * b;
-    size_t const r_size = b;
-    size_t const total_size = j_size + r_size;
-
-    uint32_t *data = gvector_alloc(total_size, total_size, sizeof(uint32_t));
-    if (data == NULL)
-    {
-        gvector_free(box);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-    for (size_t i = 0; i < total_size; ++i) data[i] = 0;
 
-    inform_dist j_dist = { data, j_size, n };
-    inform_dist r_dist = { data + j_size, r_size, n };
-    for (size_t i = 0; i < n; ++i)
-    {
-        r_dist.histogram[responses[i]]++;
-        j_dist.histogram[stimulus[i] + bs * responses[i]]++;
-    }
-
-    double *si = gvector_alloc(bs, bs, sizeof(double));
-    if (si == NULL)
-    {
-        gvector_free(data);
-        gvector_free(box);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-
-    int joint;
-    double n_stimulus, n_response, n_joint;
-    for (int s = 0; s < bs; ++s)
-    {
-        si[s] = 0.0;
-        n_stimulus = s_dist->histogram[s];
-        if (n_stimulus == 0)
+        size_t const b = nstates[mask - 1];
+        memset(r_hist, 0, b * sizeof(uint32_t));
+        memset(j_hist, 0, b * bs * sizeof(uint32_t));
+        for (size_t t = 0; t < n; ++t)
         {
-            continue;
+            r_hist[encoding[t]]++;
+            j_hist[stimulus[t] + bs * encoding[t]]++;
         }
-        for (int r = 0; r < b; ++r)
+
+        double *row = si + (mask - 1) * bs;
+        for (int s = 0; s < bs; ++s)
         {
-            n_response = r_dist.histogram[r];
-            if (n_response == 0)
+            row[s] = 0.0;
+            double const n_stimulus = s_hist[s];
+            if (n_stimulus == 0)
             {
                 continue;
             }
-            joint = s + bs * r;
-            n_joint = j_dist.histogram[joint];
-            if (n_joint == 0)
+            for (size_t r = 0; r < b; ++r)
             {
-                continue;
+                double const n_joint = j_hist[s + bs * r];
+                if (n_joint == 0)
+                {
+                    continue;
+                }
+                double const n_response = r_hist[r];
+                row[s] += n_joint * log2((n * n_joint) / (n_stimulus * n_response));
             }
-            si[s] += n_joint * log2((n * n_joint) / (n_stimulus * n_response));
+            row[s] /= n_stimulus;
         }
-        si[s] /= n_stimulus;
     }
 
-    gvector_free(data);
-    gvector_free(box);
+    free(nstates);
+    free(j_hist);
+    free(r_hist);
+    free(codes);
+    free(encodings);
+    if (inform_failed(err))
+    {
+        free(si);
+        return NULL;
+    }
     return si;
 }
 
-static void cleanup(size_t **subsets, inform_dist *s_dist, double **info)
+// the minimum specific information of the members of a node
+inline static double node_info(inform_pid_lattice const *lattice, size_t i,
+    double const *si, int bs, int s)
 {
-    if (subsets)
+    size_t const *name = lattice->names + lattice->name_offsets[i];
+    size_t const size = lattice->name_offsets[i + 1] - lattice->name_offsets[i];
+    double x = si[(name[0] - 1) * bs + s];
+    for (size_t k = 1; k < size; ++k)
     {
-        for (size_t i = 0; i < gvector_len(subsets); ++i)
-        {
-            gvector_free(subsets[i]);
-        }
-        gvector_free(subsets);
-    }
-
-    if (s_dist)
-    {
-        inform_dist_free(s_dist);
-    }
-
-    if (info)
-    {
-        for (size_t i = 0; i < gvector_len(info); ++i)
-        {
-            gvector_free(info[i]);
-        }
-        gvector_free(info);
+        x = MIN(x, si[(name[k] - 1) * bs + s]);
     }
+    return x;
 }
 
 static bool check_arguments( int const *stimulus, int const *responses, size_t l, size_t n,
@@ -641,87 +452,58 @@ inform_pid_lattice *inform_pid(int const *stimulus, int const *responses,
     {
         return NULL;
     }
-    size_t **ss = subsets(l, err);
-    if (FAILED(err))
+    else if (l > PID_MAX_SOURCES)
     {
-        return NULL;
+        INFORM_ERROR_RETURN(err, INFORM_ESIZE, NULL);
     }
 
-    size_t const m = gvector_len(ss);
-
-    inform_dist *s_dist = inform_dist_infer(stimulus, n);
-    if (s_dist == NULL)
+    uint32_t *s_hist = calloc(bs, sizeof(uint32_t));
+    if (s_hist == NULL)
     {
-        cleanup(ss, NULL, NULL);
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
+    for (size_t t = 0; t < n; ++t) s_hist[stimulus[t]]++;
 
-    double **si = gvector_alloc(m, m, sizeof(double*));
+    double *si = specific_info(stimulus, responses, l, n, bs, br, s_hist, err);
     if (si == NULL)
     {
-        cleanup(ss, s_dist, si);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
-    }
-    for (size_t i = 0; i < m; ++i) si[i] = NULL;
-    for (size_t i = 0; i < m; ++i)
-    {
-        si[i] = specific_info(stimulus, responses, l, n, bs, br, ss[i], s_dist, err);
-        if (FAILED(err))
-        {
-            cleanup(ss, s_dist, si);
-            return NULL;
-        }
+        free(s_hist);
+        return NULL;
     }
 
-    inform_pid_lattice *lattice = hasse(l, err);
-    if (FAILED(err))
+    inform_pid_lattice *lattice = inform_pid_lattice_alloc(l, err);
+    if (lattice == NULL)
     {
-        cleanup(ss, s_dist, si);
+        free(si);
+        free(s_hist);
         return NULL;
     }
 
     for (size_t i = 0; i < lattice->size; ++i)
     {
-        inform_pid_source *alpha = lattice->sources[i];
-        alpha->imin = 0.0;
-        for (size_t s = 0; s < (size_t)bs; ++s)
+        double imin = 0.0, below = 0.0;
+        for (int s = 0; s < bs; ++s)
         {
-            double x = si[alpha->name[0]-1][s];
-            for (size_t k = 1; k < alpha->size; ++k)
-            {
-                x = MIN(x, si[alpha->name[k]-1][s]);
-            }
-            alpha->imin += s_dist->histogram[s] * x;
-        }
-        alpha->imin /= s_dist->counts;
-    }
+            imin += s_hist[s] * node_info(lattice, i, si, bs, s);
 
-    for (size_t i = 0; i < lattice->size; ++i)
-    {
-        inform_pid_source *alpha = lattice->sources[i];
-        for (size_t s = 0; s < (size_t)bs; ++s)
-        {
             double u = -INFINITY;
-            for (size_t j = 0; j < alpha->n_below; ++j)
+            for (size_t j = lattice->below_offsets[i];
+                j < lattice->below_offsets[i + 1]; ++j)
             {
-                inform_pid_source *beta = alpha->below[j];
-                double x = si[beta->name[0]-1][s];
-                for (size_t k = 1; k < beta->size; ++k)
-                {
-                    x = MIN(x, si[beta->name[k]-1][s]);
-                }
-                u = MAX(u, x);
+                u = MAX(u, node_info(lattice, lattice->below[j], si, bs, s));
             }
             if (isinf(u))
             {
                 u = 0.0;
             }
-            alpha->pi += s_dist->histogram[s] * u;
+            below += s_hist[s] * u;
         }
-        alpha->pi = alpha->imin - alpha->pi / s_dist->counts;
+        lattice->imin[i] = imin / n;
+        lattice->pi[i] = (imin - below) / n;
     }
 
-    cleanup(ss, s_dist, si);
+    free(si);
+    free(s_hist);
 
     return lattice;
 }
@@ -1,63 +1,279 @@
 // Copyright 2016-2017 ELIFE. All rights reserved.
 // Use of this source code is governed by a MIT
 // license that can be found in the LICENSE file.
-#include <inform/active_info.h>
-#include <inform/transfer_entropy.h>
+#include <inform/separable_info.h>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 
-double inform_separable_info(int const *srcs, int const *dest, size_t l,
+static bool check_states(int const *series, size_t size, int b,
+    inform_error *err)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (series[i] < 0)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+        }
+        else if (b <= series[i])
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+        }
+    }
+    return false;
+}
+
+static bool check_arguments(int const *srcs, int const *dest, size_t l,
     size_t n, size_t m, int b, size_t k, inform_error *err)
 {
-    if (l < 1) INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NAN);
+    if (l < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, true);
+    }
+    else if (srcs == NULL || dest == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, true);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, true);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, true);
+    }
+    return check_states(dest, n * m, b, err) ||
+        check_states(srcs, l * n * m, b, err);
+}
+
+// Encode the k-history of the destination at each observation, and its
+// successor (the history followed by the next state), accumulating their
+// histograms and that of the next states.
+static void encode_destination(int const *dest, size_t n, size_t m, int b,
+    size_t k, int *history, int *predicate, uint32_t *histories,
+    uint32_t *predicates, uint32_t *futures)
+{
+    for (size_t i = 0; i < n; ++i, dest += m)
+    {
+        int h = 0, q = 1;
+        for (size_t j = 0; j < k; ++j)
+        {
+            q *= b;
+            h = h * b + dest[j];
+        }
+        for (size_t j = k; j < m; ++j, ++history, ++predicate)
+        {
+            *history = h;
+            *predicate = h * b + dest[j];
 
-    double si = inform_active_info(dest, n, m, b, k, err);
-    if (inform_failed(err)) return NAN;
+            histories[h]++;
+            predicates[*predicate]++;
+            futures[dest[j]]++;
 
-    for (size_t i = 0; i < l; ++i, srcs += n*m)
+            h = *predicate - dest[j - k] * q;
+        }
+    }
+}
+
+// The transfer entropy from one source to the destination, filling `table`
+// with the local transfer entropy of each observed (predicate, source) state
+// and accumulating the local values into `local` if it is not NULL.
+static double source_transfer_entropy(int const *src, size_t n, size_t m,
+    int b, size_t k, int const *history, int const *predicate,
+    uint32_t const *histories, uint32_t const *predicates, uint32_t *states,
+    uint32_t *sources, double *table, double *local)
+{
+    size_t const N = n * (m - k);
+    size_t const predicates_size = (size_t) (b * pow((double) b, (double) k));
+    memset(states, 0, b * predicates_size * sizeof(uint32_t));
+    memset(sources, 0, predicates_size * sizeof(uint32_t));
+
+    for (size_t i = 0, t = 0; i < n; ++i)
     {
-        si += inform_transfer_entropy(srcs, dest, NULL, 0, n, m, b, k, err);
-        if (inform_failed(err)) return NAN;
+        for (size_t j = k; j < m; ++j, ++t)
+        {
+            int const x = src[i * m + j - 1];
+            states[predicate[t] * b + x]++;
+            sources[history[t] * b + x]++;
+        }
     }
 
-    return si;
+    double te = 0.0;
+    for (size_t state = 0; state < b * predicates_size; ++state)
+    {
+        double const n_state = states[state];
+        if (n_state == 0)
+        {
+            continue;
+        }
+        size_t const p = state / b, h = p / b;
+        double const n_history = histories[h];
+        double const n_source = sources[h * b + state % b];
+        double const n_predicate = predicates[p];
+        table[state] = log2((n_state * n_history) / (n_source * n_predicate));
+        te += n_state * table[state];
+    }
+
+    if (local != NULL)
+    {
+        for (size_t i = 0, t = 0; i < n; ++i)
+        {
+            for (size_t j = k; j < m; ++j, ++t)
+            {
+                local[t] += table[predicate[t] * b + src[i * m + j - 1]];
+            }
+        }
+    }
+
+    return te / N;
 }
 
-double *inform_local_separable_info(int const *srcs, int const *dest,
-    size_t l, size_t n, size_t m, int b, size_t k, double *si,
-    inform_error *err)
+// The common engine of the separable information: the destination is
+// encoded once, its active information is tabulated per state, and the
+// transfer entropy from each source (in parallel when OpenMP is available)
+// reuses the destination's encoding and histograms. If `si` is not NULL, the
+// local separable information is accumulated into it.
+static double separable_info(int const *srcs, int const *dest, size_t l,
+    size_t n, size_t m, int b, size_t k, double *si, inform_error *err)
 {
-    if (l < 1) INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+    size_t const N = n * (m - k);
+    size_t const histories_size = (size_t) pow((double) b, (double) k);
+    size_t const predicates_size = b * histories_size;
+
+    int *codes = malloc(2 * N * sizeof(int));
+    uint32_t *counts = calloc(histories_size + predicates_size + b,
+        sizeof(uint32_t));
+    double *ai_table = malloc(predicates_size * sizeof(double));
+    if (codes == NULL || counts == NULL || ai_table == NULL)
+    {
+        free(ai_table);
+        free(counts);
+        free(codes);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    int *history = codes, *predicate = codes + N;
+    uint32_t *histories = counts, *predicates = counts + histories_size;
+    uint32_t *futures = predicates + predicates_size;
 
-    bool allocated_si = (si == NULL);
+    encode_destination(dest, n, m, b, k, history, predicate, histories,
+        predicates, futures);
 
-    si = inform_local_active_info(dest, n, m, b, k, si, err);
-    if (inform_failed(err))
+    double ai = 0.0;
+    for (size_t p = 0; p < predicates_size; ++p)
     {
-        if (allocated_si) free(si);
-        return NULL;
+        double const n_predicate = predicates[p];
+        if (n_predicate == 0)
+        {
+            continue;
+        }
+        double const n_history = histories[p / b], n_future = futures[p % b];
+        ai_table[p] = log2((N * n_predicate) / (n_history * n_future));
+        ai += n_predicate * ai_table[p];
+    }
+    if (si != NULL)
+    {
+        for (size_t t = 0; t < N; ++t)
+        {
+            si[t] = ai_table[predicate[t]];
+        }
     }
 
-    const size_t N = n * (m - k);
-    double *te = malloc(n * (m - k) * sizeof(double));
-    if (te == NULL)
+    double te = 0.0;
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
     {
-        if (allocated_si) free(si);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        uint32_t *hist = malloc((b + 1) * predicates_size * sizeof(uint32_t));
+        double *table = malloc(b * predicates_size * sizeof(double));
+        double *local = (si != NULL) ? calloc(N, sizeof(double)) : NULL;
+        bool const ready = (hist != NULL && table != NULL &&
+            (si == NULL || local != NULL));
+        if (!ready)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic) reduction(+:te)
+#endif
+        for (size_t i = 0; i < l; ++i)
+        {
+            if (!ready) continue;
+            te += source_transfer_entropy(srcs + i * n * m, n, m, b, k,
+                history, predicate, histories, predicates, hist,
+                hist + b * predicates_size, table, local);
+        }
+        if (ready && local != NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            for (size_t t = 0; t < N; ++t)
+            {
+                si[t] += local[t];
+            }
+        }
+        free(local);
+        free(table);
+        free(hist);
+    }
+
+    free(ai_table);
+    free(counts);
+    free(codes);
+
+    if (failed)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
     }
+    return ai / N + te;
+}
+
+double inform_separable_info(int const *srcs, int const *dest, size_t l,
+    size_t n, size_t m, int b, size_t k, inform_error *err)
+{
+    if (check_arguments(srcs, dest, l, n, m, b, k, err)) return NAN;
 
-    for (size_t i = 0; i < l; ++i, srcs += n*m)
+    return separable_info(srcs, dest, l, n, m, b, k, NULL, err);
+}
+
+double *inform_local_separable_info(int const *srcs, int const *dest,
+    size_t l, size_t n, size_t m, int b, size_t k, double *si,
+    inform_error *err)
+{
+    if (check_arguments(srcs, dest, l, n, m, b, k, err)) return NULL;
+
+    bool allocate = (si == NULL);
+    if (allocate)
     {
-        inform_local_transfer_entropy(srcs, dest, NULL, 0, n, m, b, k, te, err);
-        if (inform_failed(err))
+        si = malloc(n * (m - k) * sizeof(double));
+        if (si == NULL)
         {
-            free(te);
-            if (allocated_si) free(si);
-            return NULL;
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
         }
-        for (size_t j = 0; j < N; ++j) si[j] += te[j];
     }
 
-    free(te);
+    separable_info(srcs, dest, l, n, m, b, k, si, err);
+    if (inform_failed(err))
+    {
+        if (allocate) free(si);
+        return NULL;
+    }
 
     return si;
 }
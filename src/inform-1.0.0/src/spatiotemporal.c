@@ -0,0 +1,346 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/spatiotemporal.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+static size_t lattice_cells(inform_lattice const *lattice)
+{
+    size_t cells = 1;
+    for (size_t d = 0; d < lattice->dims; ++d)
+    {
+        cells *= lattice->shape[d];
+    }
+    return cells;
+}
+
+// The cell at `offset` from the cell `c`, or `cells` if it lies beyond a
+// fixed boundary.
+static size_t neighbour(inform_lattice const *lattice, size_t cells, size_t c,
+    int const *offset)
+{
+    size_t index = 0, stride = 1;
+    for (size_t d = 0; d < lattice->dims; ++d)
+    {
+        long const size = lattice->shape[d];
+        long x = (long) (c % size) + offset[d];
+        c /= size;
+        if (x < 0 || size <= x)
+        {
+            if (lattice->boundary == INFORM_BOUNDARY_FIXED)
+            {
+                return cells;
+            }
+            x = ((x % size) + size) % size;
+        }
+        index += x * stride;
+        stride *= size;
+    }
+    return index;
+}
+
+static bool check_arguments(int const *series, inform_lattice const *lattice,
+    size_t m, int b, size_t k, inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (lattice == NULL || lattice->dims < 1 || 2 < lattice->dims)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+    }
+    else if (lattice->boundary != INFORM_BOUNDARY_PERIODIC &&
+        lattice->boundary != INFORM_BOUNDARY_FIXED)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+    }
+    else if (lattice_cells(lattice) < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, true);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, true);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, true);
+    }
+    size_t const size = lattice_cells(lattice) * m;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (series[i] < 0)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+        }
+        else if (b <= series[i])
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+        }
+    }
+    return false;
+}
+
+// Encode the k-history of a cell at each time step, and its successor (the
+// history followed by the next state).
+static void encode_cell(int const *series, size_t m, int b, size_t k,
+    int *history, int *predicate)
+{
+    int h = 0, q = 1;
+    for (size_t j = 0; j < k; ++j)
+    {
+        q *= b;
+        h = h * b + series[j];
+    }
+    for (size_t j = k; j < m; ++j, ++history, ++predicate)
+    {
+        *history = h;
+        *predicate = h * b + series[j];
+        h = *predicate - series[j - k] * q;
+    }
+}
+
+// Accumulate into `out` the local transfer entropy into each cell from its
+// neighbour in `sources_of`, pooling the histograms across the cells.
+static bool neighbour_transfer_entropy(int const *series, size_t cells,
+    size_t const *sources_of, size_t m, int b, size_t k, int const *history,
+    int const *predicate, uint32_t const *histories,
+    uint32_t const *predicates, uint32_t *states, double *table, double *out)
+{
+    size_t const w = m - k;
+    size_t const states_size = (size_t) (b * b * pow((double) b, (double) k));
+    uint32_t *sources = states + states_size;
+    memset(states, 0, (states_size + states_size / b) * sizeof(uint32_t));
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *counts = calloc(states_size + states_size / b,
+            sizeof(uint32_t));
+        if (counts == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (size_t c = 0; c < cells; ++c)
+        {
+            if (counts == NULL) continue;
+            int const *h = history + c * w, *p = predicate + c * w;
+            int const *src = (sources_of[c] == cells) ? NULL :
+                series + sources_of[c] * m + k - 1;
+            for (size_t t = 0; t < w; ++t)
+            {
+                int const x = (src == NULL) ? 0 : src[t];
+                counts[p[t] * b + x]++;
+                counts[states_size + h[t] * b + x]++;
+            }
+        }
+        if (counts != NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            for (size_t s = 0; s < states_size + states_size / b; ++s)
+            {
+                states[s] += counts[s];
+            }
+        }
+        free(counts);
+    }
+    if (failed)
+    {
+        return false;
+    }
+
+    for (size_t state = 0; state < states_size; ++state)
+    {
+        double const n_state = states[state];
+        if (n_state == 0)
+        {
+            continue;
+        }
+        size_t const p = state / b, h = p / b;
+        double const n_history = histories[h];
+        double const n_source = sources[h * b + state % b];
+        double const n_predicate = predicates[p];
+        table[state] = log2((n_state * n_history) / (n_source * n_predicate));
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (size_t c = 0; c < cells; ++c)
+    {
+        int const *p = predicate + c * w;
+        int const *src = (sources_of[c] == cells) ? NULL :
+            series + sources_of[c] * m + k - 1;
+        for (size_t t = 0; t < w; ++t)
+        {
+            int const x = (src == NULL) ? 0 : src[t];
+            out[c * w + t] += table[p[t] * b + x];
+        }
+    }
+    return true;
+}
+
+// The common engine of the lattice measures: the local active information
+// (if `active`) plus the local transfer entropy from the neighbour at each
+// offset. The histories of the cells are encoded once and shared by all of
+// the measures.
+static double *lattice_info(int const *series, inform_lattice const *lattice,
+    int const *offsets, size_t noffsets, bool active, size_t m, int b,
+    size_t k, double *out, inform_error *err)
+{
+    size_t const cells = lattice_cells(lattice);
+    size_t const w = m - k, N = cells * w;
+    size_t const histories_size = (size_t) pow((double) b, (double) k);
+    size_t const predicates_size = b * histories_size;
+    size_t const states_size = b * predicates_size;
+
+    bool const allocate = (out == NULL);
+    if (allocate)
+    {
+        out = malloc(N * sizeof(double));
+    }
+    int *codes = malloc(2 * N * sizeof(int));
+    uint32_t *counts = calloc(histories_size + predicates_size + b +
+        states_size + predicates_size, sizeof(uint32_t));
+    double *table = malloc(states_size * sizeof(double));
+    size_t *sources_of = malloc(cells * sizeof(size_t));
+    if (out == NULL || codes == NULL || counts == NULL || table == NULL ||
+        sources_of == NULL)
+    {
+        free(sources_of);
+        free(table);
+        free(counts);
+        free(codes);
+        if (allocate) free(out);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    int *history = codes, *predicate = codes + N;
+    uint32_t *histories = counts, *predicates = histories + histories_size;
+    uint32_t *futures = predicates + predicates_size;
+    uint32_t *states = futures + b;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (size_t c = 0; c < cells; ++c)
+    {
+        encode_cell(series + c * m, m, b, k, history + c * w,
+            predicate + c * w);
+    }
+    for (size_t t = 0; t < N; ++t)
+    {
+        histories[history[t]]++;
+        predicates[predicate[t]]++;
+        futures[predicate[t] % b]++;
+    }
+
+    if (active)
+    {
+        for (size_t p = 0; p < predicates_size; ++p)
+        {
+            double const n_predicate = predicates[p];
+            if (n_predicate == 0)
+            {
+                continue;
+            }
+            double const n_history = histories[p / b];
+            double const n_future = futures[p % b];
+            table[p] = log2((N * n_predicate) / (n_history * n_future));
+        }
+        for (size_t t = 0; t < N; ++t)
+        {
+            out[t] = table[predicate[t]];
+        }
+    }
+    else
+    {
+        memset(out, 0, N * sizeof(double));
+    }
+
+    bool failed = false;
+    for (size_t o = 0; o < noffsets && !failed; ++o)
+    {
+        int const *offset = offsets + o * lattice->dims;
+        for (size_t c = 0; c < cells; ++c)
+        {
+            sources_of[c] = neighbour(lattice, cells, c, offset);
+        }
+        failed = !neighbour_transfer_entropy(series, cells, sources_of, m, b,
+            k, history, predicate, histories, predicates, states, table, out);
+    }
+
+    free(sources_of);
+    free(table);
+    free(counts);
+    free(codes);
+
+    if (failed)
+    {
+        if (allocate) free(out);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return out;
+}
+
+double *inform_lattice_local_active_info(int const *series,
+    inform_lattice const *lattice, size_t m, int b, size_t k, double *ai,
+    inform_error *err)
+{
+    if (check_arguments(series, lattice, m, b, k, err))
+    {
+        return NULL;
+    }
+    return lattice_info(series, lattice, NULL, 0, true, m, b, k, ai, err);
+}
+
+double *inform_lattice_local_transfer_entropy(int const *series,
+    inform_lattice const *lattice, int const *offset, size_t m, int b,
+    size_t k, double *te, inform_error *err)
+{
+    if (offset == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+    }
+    else if (check_arguments(series, lattice, m, b, k, err))
+    {
+        return NULL;
+    }
+    return lattice_info(series, lattice, offset, 1, false, m, b, k, te, err);
+}
+
+double *inform_lattice_local_separable_info(int const *series,
+    inform_lattice const *lattice, int const *offsets, size_t noffsets,
+    size_t m, int b, size_t k, double *si, inform_error *err)
+{
+    if (offsets == NULL || noffsets == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+    }
+    else if (check_arguments(series, lattice, m, b, k, err))
+    {
+        return NULL;
+    }
+    return lattice_info(series, lattice, offsets, noffsets, true, m, b, k, si,
+        err);
+}
@@ -0,0 +1,356 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/subset_entropy.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SUBSET_MAX_VARIABLES 30
+#define SUBSET_DENSE_STATES (1 << 16)
+#define SUBSET_SPLIT_VARIABLES 4
+
+// A state of a sparse histogram and the number of times it was observed.
+typedef struct subset_entry
+{
+    uint64_t code;
+    uint64_t count;
+} subset_entry;
+
+// The histograms are marginalised depth-first. A subset whose lowest absent
+// variable is `v` is reached from its parent, the subset with `v` added, so
+// the variables below `v` are always present. In the mixed-radix encoding of
+// a subset (variable 0 least significant) the place value of `v` is then the
+// product of the bases of all of the variables below it, whatever the rest of
+// the subset.
+typedef struct subset_context
+{
+    size_t l, n;
+    int const *b;
+    uint64_t const *place;
+    double *h;
+} subset_context;
+
+static bool check_arguments(int const *series, size_t l, size_t n,
+    int const *b, inform_error *err)
+{
+    if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (l < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, true);
+    }
+    else if (SUBSET_MAX_VARIABLES < l)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, true);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (b == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+    }
+    double bits = 0.0;
+    for (size_t i = 0; i < l; ++i)
+    {
+        if (b[i] < 2)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBASE, true);
+        }
+        bits += log2(b[i]);
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (series[i * n + j] < 0)
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ENEGSTATE, true);
+            }
+            else if (b[i] <= series[i * n + j])
+            {
+                INFORM_ERROR_RETURN(err, INFORM_EBADSTATE, true);
+            }
+        }
+    }
+    if (63.0 <= bits)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EENCODE, true);
+    }
+    return false;
+}
+
+static int compare_entries(void const *a, void const *b)
+{
+    uint64_t const x = ((subset_entry const *) a)->code;
+    uint64_t const y = ((subset_entry const *) b)->code;
+    return (x > y) - (x < y);
+}
+
+// Sort the entries by state and merge the duplicates, returning the number of
+// distinct states.
+static size_t merge_entries(subset_entry *entries, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    qsort(entries, size, sizeof(subset_entry), compare_entries);
+    size_t last = 0;
+    for (size_t i = 1; i < size; ++i)
+    {
+        if (entries[i].code == entries[last].code)
+        {
+            entries[last].count += entries[i].count;
+        }
+        else
+        {
+            entries[++last] = entries[i];
+        }
+    }
+    return last + 1;
+}
+
+static double dense_entropy(uint32_t const *hist, size_t size, double n)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (hist[i] != 0)
+        {
+            sum += hist[i] * log2(hist[i]);
+        }
+    }
+    return log2(n) - sum / n;
+}
+
+static double sparse_entropy(subset_entry const *entries, size_t size,
+    double n)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        double const c = (double) entries[i].count;
+        sum += c * log2(c);
+    }
+    return log2(n) - sum / n;
+}
+
+// Sum a dense histogram over the variable with place value `place` and base
+// `b`, returning the size of the marginal.
+static size_t dense_marginalize(uint32_t const *hist, size_t size,
+    uint64_t place, int b, uint32_t *marginal)
+{
+    size_t const outer = size / (place * b);
+    memset(marginal, 0, (size / b) * sizeof(uint32_t));
+    for (size_t hi = 0; hi < outer; ++hi)
+    {
+        for (int x = 0; x < b; ++x)
+        {
+            uint32_t const *row = hist + (hi * b + x) * place;
+            uint32_t *out = marginal + hi * place;
+            for (size_t lo = 0; lo < place; ++lo)
+            {
+                out[lo] += row[lo];
+            }
+        }
+    }
+    return size / b;
+}
+
+static size_t sparse_marginalize(subset_entry const *entries, size_t size,
+    uint64_t place, int b, subset_entry *marginal)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint64_t const code = entries[i].code;
+        marginal[i].code = code % place + (code / (place * b)) * place;
+        marginal[i].count = entries[i].count;
+    }
+    return merge_entries(marginal, size);
+}
+
+static void dense_visit(subset_context const *ctx, size_t mask,
+    uint32_t const *hist, size_t size, uint32_t *arena)
+{
+    ctx->h[mask] = dense_entropy(hist, size, (double) ctx->n);
+    for (size_t v = 0; v < ctx->l && ((mask >> v) & 1); ++v)
+    {
+        size_t const marginal_size = dense_marginalize(hist, size,
+            ctx->place[v], ctx->b[v], arena);
+        dense_visit(ctx, mask & ~((size_t) 1 << v), arena, marginal_size,
+            arena + marginal_size);
+    }
+}
+
+static void sparse_visit(subset_context const *ctx, size_t mask,
+    subset_entry const *entries, size_t size, subset_entry *arena)
+{
+    ctx->h[mask] = sparse_entropy(entries, size, (double) ctx->n);
+    for (size_t v = 0; v < ctx->l && ((mask >> v) & 1); ++v)
+    {
+        size_t const marginal_size = sparse_marginalize(entries, size,
+            ctx->place[v], ctx->b[v], arena);
+        sparse_visit(ctx, mask & ~((size_t) 1 << v), arena, marginal_size,
+            arena + ctx->n);
+    }
+}
+
+// The place value of the variable `v` within the subset `mask`.
+static uint64_t subset_place(int const *b, size_t mask, size_t v)
+{
+    uint64_t place = 1;
+    for (size_t i = 0; i < v; ++i)
+    {
+        if ((mask >> i) & 1)
+        {
+            place *= b[i];
+        }
+    }
+    return place;
+}
+
+double *inform_subset_entropy(int const *series, size_t l, size_t n,
+    int const *b, double *h, inform_error *err)
+{
+    if (check_arguments(series, l, n, b, err))
+    {
+        return NULL;
+    }
+
+    size_t const subsets = (size_t) 1 << l;
+    size_t const full = subsets - 1;
+    uint64_t place[SUBSET_MAX_VARIABLES + 1];
+    place[0] = 1;
+    for (size_t i = 0; i < l; ++i)
+    {
+        place[i + 1] = place[i] * b[i];
+    }
+    uint64_t const states = place[l];
+    bool const dense = (states <= n || states <= SUBSET_DENSE_STATES);
+
+    bool const allocate = (h == NULL);
+    if (allocate)
+    {
+        h = malloc(subsets * sizeof(double));
+    }
+    uint32_t *hist = dense ? calloc(states, sizeof(uint32_t)) : NULL;
+    subset_entry *entries = dense ? NULL : malloc(n * sizeof(subset_entry));
+    if (h == NULL || (dense ? hist == NULL : entries == NULL))
+    {
+        free(entries);
+        free(hist);
+        if (allocate) free(h);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    size_t size = dense ? states : n;
+    for (size_t j = 0; j < n; ++j)
+    {
+        uint64_t code = 0;
+        for (size_t i = l; i > 0; --i)
+        {
+            code = code * b[i - 1] + series[(i - 1) * n + j];
+        }
+        if (dense)
+        {
+            hist[code]++;
+        }
+        else
+        {
+            entries[j].code = code;
+            entries[j].count = 1;
+        }
+    }
+    if (!dense)
+    {
+        size = merge_entries(entries, n);
+    }
+
+    // The subsets are split into groups by which of the top few variables
+    // they contain. The histogram of each group is marginalised directly
+    // from the joint histogram, and the subsets of the remaining variables
+    // are visited depth-first, so that the groups are independent.
+    size_t const split = (l < SUBSET_SPLIT_VARIABLES) ?
+        l : SUBSET_SPLIT_VARIABLES;
+    size_t const low = l - split;
+    subset_context const ctx = { low, n, b, place, h };
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        // two buffers to marginalise the top variables, and the arena of the
+        // depth-first visits
+        size_t const arena_size = dense ? 3 * states : (low + 3) * n;
+        void *arena = malloc(arena_size *
+            (dense ? sizeof(uint32_t) : sizeof(subset_entry)));
+        if (arena == NULL)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (size_t group = 0; group < ((size_t) 1 << split); ++group)
+        {
+            if (arena == NULL) continue;
+            size_t const top = group << low;
+            size_t mask = full;
+            size_t group_size = size;
+            void const *from = dense ? (void const *) hist :
+                (void const *) entries;
+            for (size_t v = l; v > low; --v)
+            {
+                if ((top >> (v - 1)) & 1)
+                {
+                    continue;
+                }
+                uint64_t const v_place = subset_place(b, mask, v - 1);
+                int const parity = (from == arena) ? 1 : 0;
+                if (dense)
+                {
+                    uint32_t *to = (uint32_t *) arena + parity * states;
+                    group_size = dense_marginalize(from, group_size, v_place,
+                        b[v - 1], to);
+                    from = to;
+                }
+                else
+                {
+                    subset_entry *to = (subset_entry *) arena + parity * n;
+                    group_size = sparse_marginalize(from, group_size,
+                        v_place, b[v - 1], to);
+                    from = to;
+                }
+                mask &= ~((size_t) 1 << (v - 1));
+            }
+            if (dense)
+            {
+                dense_visit(&ctx, mask, from, group_size,
+                    (uint32_t *) arena + 2 * states);
+            }
+            else
+            {
+                sparse_visit(&ctx, mask, from, group_size,
+                    (subset_entry *) arena + 2 * n);
+            }
+        }
+        free(arena);
+    }
+
+    free(entries);
+    free(hist);
+
+    if (failed)
+    {
+        if (allocate) free(h);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    h[0] = 0.0;
+    return h;
+}
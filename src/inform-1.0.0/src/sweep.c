@@ -0,0 +1,341 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <float.h>
+#include <inform/sweep.h>
+#include <inform/utilities/binning.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/// the largest joint histogram (in bins) a sweep will accumulate
+#define SWEEP_MAX_STATES ((size_t) 1 << 32)
+
+typedef struct sweep_range
+{
+    double min, max;
+} sweep_range;
+
+static size_t ipow(size_t b, size_t k)
+{
+    size_t p = 1;
+    while (k--) p *= b;
+    return p;
+}
+
+// Bin a value into one of `b` uniform bins, clamping the values that
+// rounding places one past the last bin.
+inline static size_t bin_uniform(sweep_range r, double step, size_t b,
+    double x)
+{
+    int const bin = (int) ((x - r.min) / step) - (x == r.max);
+    return (bin < 0) ? 0 : (((size_t) bin < b) ? (size_t) bin : b - 1);
+}
+
+// Choose the resolutions to accumulate directly: visiting the resolutions
+// from finest to coarsest, each one either divides a resolution that is
+// already accumulated (and is derived from it) or must be accumulated too.
+static size_t plan_resolutions(int const *bs, size_t nb, size_t *parent,
+    size_t *direct)
+{
+    size_t ndirect = 0;
+    for (size_t i = 0; i < nb; ++i) parent[i] = nb;
+    for (size_t t = 0; t < nb; ++t)
+    {
+        size_t x = nb;
+        for (size_t i = 0; i < nb; ++i)
+        {
+            if (parent[i] == nb && (x == nb || bs[x] < bs[i])) x = i;
+        }
+        for (size_t d = 0; d < ndirect && parent[x] == nb; ++d)
+        {
+            if (bs[direct[d]] % bs[x] == 0) parent[x] = direct[d];
+        }
+        if (parent[x] == nb)
+        {
+            parent[x] = x;
+            direct[ndirect++] = x;
+        }
+    }
+    return ndirect;
+}
+
+// Merge the bins of a histogram of d-digit states in base B into a histogram
+// of d-digit states in base b, where b divides B.
+static void coarsen(uint32_t const *fine, int B, size_t d, int b,
+    uint32_t *coarse)
+{
+    size_t const fine_size = ipow(B, d);
+    int const c = B / b;
+    memset(coarse, 0, ipow(b, d) * sizeof(uint32_t));
+    for (size_t s = 0; s < fine_size; ++s)
+    {
+        if (fine[s] == 0) continue;
+        size_t t = s, state = 0, place = 1;
+        for (size_t p = 0; p < d; ++p, t /= B, place *= b)
+        {
+            state += ((t % B) / c) * place;
+        }
+        coarse[state] += fine[s];
+    }
+}
+
+static double active_info_from_joint(uint32_t const *states, int b, size_t k,
+    size_t N, uint32_t *scratch)
+{
+    size_t const states_size = ipow(b, k + 1);
+    uint32_t *histories = scratch, *futures = scratch + states_size / b;
+    memset(scratch, 0, (states_size / b + b) * sizeof(uint32_t));
+    for (size_t s = 0; s < states_size; ++s)
+    {
+        histories[s / b] += states[s];
+        futures[s % b] += states[s];
+    }
+
+    double ai = 0.0;
+    for (size_t s = 0; s < states_size; ++s)
+    {
+        double n_state = states[s];
+        if (n_state == 0) continue;
+        double n_history = histories[s / b], n_future = futures[s % b];
+        ai += n_state * log2((N * n_state) / (n_history * n_future));
+    }
+    return ai / N;
+}
+
+static double transfer_entropy_from_joint(uint32_t const *states, int b,
+    size_t k, size_t N, uint32_t *scratch)
+{
+    // each state is ((history * b) + future) * b + source
+    size_t const bb = (size_t) b * b;
+    size_t const states_size = ipow(b, k + 2);
+    uint32_t *histories = scratch;
+    uint32_t *sources = histories + states_size / bb;
+    uint32_t *predicates = sources + states_size / b;
+    memset(scratch, 0, (states_size / bb + 2 * states_size / b) *
+        sizeof(uint32_t));
+    for (size_t s = 0; s < states_size; ++s)
+    {
+        histories[s / bb] += states[s];
+        sources[(s / bb) * b + s % b] += states[s];
+        predicates[s / b] += states[s];
+    }
+
+    double te = 0.0;
+    for (size_t s = 0; s < states_size; ++s)
+    {
+        double n_state = states[s];
+        if (n_state == 0) continue;
+        double n_history = histories[s / bb];
+        double n_source = sources[(s / bb) * b + s % b];
+        double n_predicate = predicates[s / b];
+        te += n_state * log2((n_state * n_history) / (n_source * n_predicate));
+    }
+    return te / N;
+}
+
+static bool check_arguments(double const *src, double const *dst, size_t n,
+    size_t m, int const *bs, size_t nb, size_t k, inform_error *err)
+{
+    if (dst == NULL || src == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, true);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, true);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, true);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, true);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, true);
+    }
+    else if (bs == NULL || nb == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, true);
+    }
+    for (size_t i = 0; i < nb; ++i)
+    {
+        if (bs[i] < 2)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, true);
+        }
+    }
+    for (size_t i = 0; i < n * m; ++i)
+    {
+        if (!isfinite(src[i]) || !isfinite(dst[i]))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, true);
+        }
+    }
+    return false;
+}
+
+// The common engine of the sweeps: `digits` is k + 1 for active information
+// (src == NULL) and k + 2 for transfer entropy.
+static double *sweep(double const *src, double const *dst, size_t n, size_t m,
+    int const *bs, size_t nb, size_t k, double *out, inform_error *err)
+{
+    bool const te = (src != NULL);
+    size_t const digits = te ? k + 2 : k + 1;
+    size_t const N = n * (m - k);
+
+    sweep_range src_range = { 0.0, 0.0 }, dst_range;
+    inform_range(dst, n * m, &dst_range.min, &dst_range.max, err);
+    if (te) inform_range(src, n * m, &src_range.min, &src_range.max, err);
+    if (inform_failed(err))
+    {
+        return NULL;
+    }
+
+    size_t *plan = malloc(2 * nb * sizeof(size_t));
+    if (plan == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t *parent = plan, *direct = plan + nb;
+    size_t const ndirect = plan_resolutions(bs, nb, parent, direct);
+
+    // the per-resolution scan state, and the offsets of their histograms
+    size_t *offsets = malloc(3 * ndirect * sizeof(size_t));
+    double *steps = malloc(2 * ndirect * sizeof(double));
+    if (offsets == NULL || steps == NULL)
+    {
+        free(steps);
+        free(offsets);
+        free(plan);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t *q = offsets + ndirect, *history = q + ndirect;
+    size_t total = 0, scratch_size = 0;
+    for (size_t r = 0; r < ndirect; ++r)
+    {
+        int const B = bs[direct[r]];
+        if (pow((double) B, (double) digits) > (double) SWEEP_MAX_STATES)
+        {
+            INFORM_ERROR(err, INFORM_ENOMEM);
+            break;
+        }
+        offsets[r] = total;
+        total += ipow(B, digits);
+        q[r] = ipow(B, k);
+        steps[2*r] = (dst_range.max - dst_range.min) / B;
+        steps[2*r + 1] = (src_range.max - src_range.min) / B;
+        if (steps[2*r] <= 10.*DBL_EPSILON ||
+            (te && steps[2*r + 1] <= 10.*DBL_EPSILON))
+        {
+            INFORM_ERROR(err, INFORM_EBIN);
+            break;
+        }
+    }
+    for (size_t i = 0; i < nb; ++i)
+    {
+        // room for a coarsened histogram and its marginals
+        size_t states_size = ipow(bs[i], digits);
+        size_t need = states_size + 2 * states_size / bs[i] + bs[i];
+        scratch_size = (scratch_size < need) ? need : scratch_size;
+    }
+
+    uint32_t *histograms = NULL, *scratch = NULL;
+    bool allocate = (out == NULL);
+    if (inform_succeeded(err))
+    {
+        histograms = calloc(total, sizeof(uint32_t));
+        scratch = malloc(scratch_size * sizeof(uint32_t));
+        if (allocate) out = malloc(nb * sizeof(double));
+        if (histograms == NULL || scratch == NULL || out == NULL)
+        {
+            INFORM_ERROR(err, INFORM_ENOMEM);
+        }
+    }
+    if (inform_failed(err))
+    {
+        if (allocate) free(out);
+        free(scratch);
+        free(histograms);
+        free(steps);
+        free(offsets);
+        free(plan);
+        return NULL;
+    }
+
+    // a single scan over the series updates every accumulated resolution
+    for (size_t i = 0; i < n; ++i)
+    {
+        double const *x = dst + m*i, *y = te ? src + m*i : NULL;
+        for (size_t r = 0; r < ndirect; ++r) history[r] = 0;
+        for (size_t j = 0; j < m; ++j)
+        {
+            for (size_t r = 0; r < ndirect; ++r)
+            {
+                size_t const B = bs[direct[r]];
+                size_t state = history[r] * B +
+                    bin_uniform(dst_range, steps[2*r], B, x[j]);
+                if (j < k)
+                {
+                    history[r] = state;
+                    continue;
+                }
+                if (te)
+                {
+                    state = state * B +
+                        bin_uniform(src_range, steps[2*r + 1], B, y[j - 1]);
+                    histograms[offsets[r] + state]++;
+                    history[r] = (state / B) % q[r];
+                }
+                else
+                {
+                    histograms[offsets[r] + state]++;
+                    history[r] = state % q[r];
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < nb; ++i)
+    {
+        size_t r = 0;
+        while (direct[r] != parent[i]) ++r;
+        uint32_t const *states = histograms + offsets[r];
+        uint32_t *marginals = scratch;
+        if (parent[i] != i)
+        {
+            coarsen(states, bs[parent[i]], digits, bs[i], scratch);
+            states = scratch;
+            marginals = scratch + ipow(bs[i], digits);
+        }
+        out[i] = te ?
+            transfer_entropy_from_joint(states, bs[i], k, N, marginals) :
+            active_info_from_joint(states, bs[i], k, N, marginals);
+    }
+
+    free(scratch);
+    free(histograms);
+    free(steps);
+    free(offsets);
+    free(plan);
+
+    return out;
+}
+
+double *inform_active_info_sweep(double const *series, size_t n, size_t m,
+    int const *bs, size_t nb, size_t k, double *ai, inform_error *err)
+{
+    if (check_arguments(series, series, n, m, bs, nb, k, err)) return NULL;
+    return sweep(NULL, series, n, m, bs, nb, k, ai, err);
+}
+
+double *inform_transfer_entropy_sweep(double const *src, double const *dst,
+    size_t n, size_t m, int const *bs, size_t nb, size_t k, double *te,
+    inform_error *err)
+{
+    if (check_arguments(src, dst, n, m, bs, nb, k, err)) return NULL;
+    return sweep(src, dst, n, m, bs, nb, k, te, err);
+}
@@ -95,6 +95,92 @@ static void accumulate_local_observations(int const *src, int const *dst,
     }
 }
 
+static void accumulate_binned_observations(double const *src,
+    double const *dst, double const *back, size_t l, size_t n, size_t m,
+    inform_binning const *spec, int b, size_t k, inform_dist *states,
+    inform_dist *histories, inform_dist *sources, inform_dist *predicates)
+{
+    // spec holds the fitted binning of the source, the destination and each
+    // of the background nodes, in that order
+    for (size_t i = 0; i < n; ++i, src += m, dst += m)
+    {
+        int src_state, future, state, source, predicate, back_state;
+        int history = 0, q = 1;
+        for (size_t j = 0; j < k; ++j)
+        {
+            q *= b;
+            history *= b;
+            history += inform_binning_apply(spec + 1, dst[j]);
+        }
+        for (size_t j = k; j < m; ++j)
+        {
+            back_state = 0;
+            for (size_t u = 0; u < l; ++u)
+            {
+                back_state = b * back_state +
+                    inform_binning_apply(spec + 2 + u, back[j+(i+u*n)*m-1]);
+            }
+            history += back_state * q;
+
+            src_state = inform_binning_apply(spec, src[j-1]);
+            future    = inform_binning_apply(spec + 1, dst[j]);
+            source    = history * b + src_state;
+            predicate = history * b + future;
+            state     = predicate * b + src_state;
+
+            states->histogram[state]++;
+            histories->histogram[history]++;
+            sources->histogram[source]++;
+            predicates->histogram[predicate]++;
+
+            history = predicate % q;
+        }
+    }
+}
+
+static double average_transfer_entropy(inform_dist const *states,
+    inform_dist const *histories, inform_dist const *sources,
+    inform_dist const *predicates, int b, size_t N)
+{
+    double te = 0.0;
+    int predicate, source, state;
+    double n_state, n_source, n_predicate, n_history;
+    for (int history = 0; history < (int) histories->size; ++history)
+    {
+        n_history = histories->histogram[history];
+        if (n_history == 0)
+        {
+            continue;
+        }
+        for (int future = 0; future < b; ++future)
+        {
+            predicate = history * b + future;
+            n_predicate = predicates->histogram[predicate];
+            if (n_predicate == 0)
+            {
+                continue;
+            }
+            for (int src_state = 0; src_state < b; ++src_state)
+            {
+                source = history * b + src_state;
+                n_source = sources->histogram[source];
+                if (n_source == 0)
+                {
+                    continue;
+                }
+                state = predicate * b + src_state;
+                n_state = states->histogram[state];
+                if (n_state == 0)
+                {
+                    continue;
+                }
+                te += n_state * log2((n_state * n_history) / (n_source * n_predicate));
+            }
+        }
+    }
+    return te / N;
+}
+
 static bool check_arguments(int const *src, int const *dst, int const *back, 
     size_t l, size_t n, size_t m, int b, size_t k, inform_error *err)
 {
@@ -191,46 +277,12 @@ double inform_transfer_entropy(int const *src, int const *dst, int const *back,
         &sources, &predicates);
 
 
-    double te = 0.0;
-    int predicate, source, state;
-    double n_state, n_source, n_predicate, n_history;
-    for (int history = 0; history < (int) histories_size; ++history)
-    {
-        n_history = histories.histogram[history];
-        if (n_history == 0)
-        {
-            continue;
-        }
-        for (int future = 0; future < b; ++future)
-        {
-            predicate = history * b + future;
-            n_predicate = predicates.histogram[predicate];
-            if (n_predicate == 0)
-            {
-                continue;
-            }
-            for (int src_state = 0; src_state < b; ++src_state)
-            {
-                source = history * b + src_state;
-                n_source = sources.histogram[source];
-                if (n_source == 0)
-                {
-                    continue;
-                }
-                state = predicate * b + src_state;
-                n_state = states.histogram[state];
-                if (n_state == 0)
-                {
-                    continue;
-                }
-                te += n_state * log2((n_state * n_history) / (n_source * n_predicate));
-            }
-        }
-    }
+    double te = average_transfer_entropy(&states, &histories, &sources,
+        &predicates, b, N);
 
     free(data);
 
-    return te / N;
+    return te;
 }
 
 double *inform_local_transfer_entropy(int const *src, int const *dst,
@@ -300,3 +352,220 @@ double *inform_local_transfer_entropy(int const *src, int const *dst,
 
     return te;
 }
+
+double inform_transfer_entropy_binned(double const *src, double const *dst,
+    double const *back, size_t l, size_t n, size_t m,
+    inform_binning const *spec, size_t k, inform_error *err)
+{
+    if (src == NULL || dst == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NAN);
+    }
+    else if (back == NULL && l != 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NAN);
+    }
+    else if (spec == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NAN);
+    }
+    else if (n < 1)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOINITS, NAN);
+    }
+    else if (m < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NAN);
+    }
+    else if (m <= k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, NAN);
+    }
+    else if (k == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, NAN);
+    }
+
+    // each node is binned according to its own range
+    inform_binning *fitted = malloc((l + 2) * sizeof(inform_binning));
+    if (fitted == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    int b = 2;
+    for (size_t u = 0; u < l + 2 && inform_succeeded(err); ++u)
+    {
+        double const *series = (u == 0) ? src : (u == 1) ? dst :
+            back + n*m*(u - 2);
+        fitted[u] = *spec;
+        int bu = inform_binning_fit(fitted + u, series, n * m, err);
+        b = (b < bu) ? bu : b;
+    }
+    if (inform_failed(err))
+    {
+        free(fitted);
+        return NAN;
+    }
+
+    size_t const N = n * (m - k);
+
+    size_t const q = (size_t) pow((double) b, (double) k);
+    size_t const r = (size_t) pow((double) b, (double) l);
+    size_t const states_size     = b*b*q*r;
+    size_t const histories_size  = q*r;
+    size_t const sources_size    = b*q*r;
+    size_t const predicates_size = b*q*r;
+    size_t const total_size = states_size + histories_size + sources_size + predicates_size;
+
+    uint32_t *data = calloc(total_size, sizeof(uint32_t));
+    if (data == NULL)
+    {
+        free(fitted);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+
+    inform_dist states     = { data, states_size, N };
+    inform_dist histories  = { data + states_size, histories_size, N };
+    inform_dist sources    = { data + states_size + histories_size, sources_size, N };
+    inform_dist predicates = { data + states_size + histories_size + sources_size, predicates_size, N };
+
+    accumulate_binned_observations(src, dst, back, l, n, m, fitted, b, k,
+        &states, &histories, &sources, &predicates);
+
+    double te = average_transfer_entropy(&states, &histories, &sources,
+        &predicates, b, N);
+
+    free(data);
+    free(fitted);
+
+    return te;
+}
+
+// Encode the state (the history of the destination and the background, the
+// next state of the destination and the state of the source) of every initial
+// condition at time `t`, reading each time series in place.
+static void encode_ensemble_states(int const *src, int const *dst,
+    int const *back, size_t l, size_t n, size_t m, int b, size_t k, size_t t,
+    int *state)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        int s = 0;
+        for (size_t u = 0; u < l; ++u)
+        {
+            s = b * s + back[(i + u * n) * m + t - 1];
+        }
+        int const *x = dst + i * m + t - k;
+        for (size_t j = 0; j <= k; ++j)
+        {
+            s = b * s + x[j];
+        }
+        state[i] = s * b + src[i * m + t - 1];
+    }
+}
+
+// The transfer entropy of the `n` states observed at one time step. Only the
+// histogram entries which are touched are read, and they are left zeroed for
+// the next time step.
+static double ensemble_transfer_entropy(int const *state, size_t n, int b,
+    uint32_t *states, uint32_t *histories, uint32_t *sources,
+    uint32_t *predicates)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        int const predicate = state[i] / b, history = predicate / b;
+        states[state[i]]++;
+        histories[history]++;
+        sources[history * b + state[i] % b]++;
+        predicates[predicate]++;
+    }
+    double te = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        double const n_state = states[state[i]];
+        if (n_state != 0)
+        {
+            int const predicate = state[i] / b, history = predicate / b;
+            double const n_history = histories[history];
+            double const n_source = sources[history * b + state[i] % b];
+            double const n_predicate = predicates[predicate];
+            te += n_state * log2((n_state * n_history) /
+                (n_source * n_predicate));
+            states[state[i]] = 0;
+        }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        int const predicate = state[i] / b, history = predicate / b;
+        histories[history] = 0;
+        sources[history * b + state[i] % b] = 0;
+        predicates[predicate] = 0;
+    }
+    return te / n;
+}
+
+double *inform_transfer_entropy_ensemble(int const *src, int const *dst,
+    int const *back, size_t l, size_t n, size_t m, int b, size_t k,
+    double *te, inform_error *err)
+{
+    if (check_arguments(src, dst, back, l, n, m, b, k, err)) return NULL;
+
+    size_t const w = m - k;
+    size_t const q = (size_t) pow((double) b, (double) k);
+    size_t const r = (size_t) pow((double) b, (double) l);
+    size_t const states_size     = b*b*q*r;
+    size_t const histories_size  = q*r;
+    size_t const sources_size    = b*q*r;
+    size_t const predicates_size = b*q*r;
+    size_t const total_size = states_size + histories_size + sources_size + predicates_size;
+
+    bool const allocate = (te == NULL);
+    if (allocate)
+    {
+        te = malloc(w * sizeof(double));
+    }
+    if (te == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        uint32_t *data = calloc(total_size, sizeof(uint32_t));
+        int *state = malloc(n * sizeof(int));
+        bool const ready = (data != NULL && state != NULL);
+        if (!ready)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            failed = true;
+        }
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (size_t t = 0; t < w; ++t)
+        {
+            if (!ready) continue;
+            uint32_t *histories = data + states_size;
+            uint32_t *sources = histories + histories_size;
+            uint32_t *predicates = sources + sources_size;
+            encode_ensemble_states(src, dst, back, l, n, m, b, k, t + k,
+                state);
+            te[t] = ensemble_transfer_entropy(state, n, b, data, histories,
+                sources, predicates);
+        }
+        free(state);
+        free(data);
+    }
+
+    if (failed)
+    {
+        if (allocate) free(te);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return te;
+}
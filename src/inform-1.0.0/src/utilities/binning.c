@@ -7,6 +7,135 @@
 #include <math.h>
 #include <string.h>
 
+static void column_range(double const *series, size_t n, double *min,
+    double *max)
+{
+    double a = series[0], b = series[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        a = (series[i] < a) ? series[i] : a;
+        b = (b < series[i]) ? series[i] : b;
+    }
+    *min = a;
+    *max = b;
+}
+
+// Rounding can place a value just below the maximum one past the last bin,
+// so the bins are clamped to `[0, b)`.
+static void bin_uniform(double const *series, size_t n, double min, double max,
+    double step, int b, int *binned)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        int bin = (int) ((series[i] - min) / step) - (series[i] == max);
+        binned[i] = (bin < b) ? bin : b - 1;
+        assert(0 <= binned[i] && binned[i] < b);
+    }
+}
+
+static int bin_step(double const *series, size_t n, double min, double max,
+    double step, int *binned)
+{
+    double range = max - min;
+    int b = (int) ceil(range / step);
+    if (fmod(range,step) == 0.0) ++b;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        int bin = (int) ((series[i] - min) / step);
+        binned[i] = (bin < b) ? bin : b - 1;
+        assert(0 <= binned[i] && binned[i] < b);
+    }
+
+    return b;
+}
+
+inline static int upper_bound(double const *bounds, size_t m, double x)
+{
+    double const *base = bounds;
+    while (m > 1)
+    {
+        size_t half = m / 2;
+        base = (base[half] <= x) ? base + half : base;
+        m -= half;
+    }
+    return (int) (base - bounds) + (*base <= x);
+}
+
+static int bin_bounds(double const *series, size_t n, double const *bounds,
+    size_t m, int *binned)
+{
+    int b = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        binned[i] = upper_bound(bounds, m, series[i]);
+        b = (b < binned[i]) ? binned[i] : b;
+    }
+    return b + 1;
+}
+
+static bool check_bounds(double const *bounds, size_t m, inform_error *err)
+{
+    if (bounds == NULL || m == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, true);
+    }
+    for (size_t i = 1; i < m; ++i)
+    {
+        if (!(bounds[i-1] <= bounds[i]))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, true);
+        }
+    }
+    return false;
+}
+
+int inform_binning_fit(inform_binning *spec, double const *series, size_t n,
+    inform_error *err)
+{
+    if (spec == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_EFAULT, 0);
+    else if (series == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    else if (n == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!isfinite(series[i]))
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
+    }
+
+    if (spec->method == INFORM_BIN_BOUNDS)
+    {
+        if (check_bounds(spec->bounds, spec->m, err))
+            return 0;
+        spec->b = (int) spec->m + 1;
+        return spec->b;
+    }
+
+    column_range(series, n, &spec->min, &spec->max);
+    double range = spec->max - spec->min;
+    if (spec->method == INFORM_BIN_UNIFORM)
+    {
+        if (spec->b < 2)
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
+        spec->step = range / spec->b;
+        if (spec->step <= 10.*DBL_EPSILON)
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
+        return spec->b;
+    }
+    else if (spec->method == INFORM_BIN_STEP)
+    {
+        if (spec->step <= 10.*DBL_EPSILON)
+            INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
+        spec->b = (int) ceil(range / spec->step);
+        if (fmod(range, spec->step) == 0.0) ++spec->b;
+        return spec->b;
+    }
+    INFORM_ERROR_RETURN(err, INFORM_EARG, 0);
+}
+
 double inform_range(double const *series, size_t n, double *min, double *max,
     inform_error *err)
 {
@@ -15,12 +144,8 @@ double inform_range(double const *series, size_t n, double *min, double *max,
     else if (n == 0)
         INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0.0);
 
-    double a = series[0], b = series[0];
-    for (size_t i = 1; i < n; ++i)
-    {
-        if (series[i] < a) a = series[i];
-        if (b < series[i]) b = series[i];
-    }
+    double a, b;
+    column_range(series, n, &a, &b);
     if (min != NULL) *min = a;
     if (max != NULL) *max = b;
     return (b - a);
@@ -39,8 +164,8 @@ double inform_bin(double const *series, size_t n, int b, int *binned,
         INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0.0);
 
     double min, max;
-    double range = inform_range(series, n, &min, &max, err);
-    double step = range / b;
+    column_range(series, n, &min, &max);
+    double step = (max - min) / b;
 
     if (step <= 10.*DBL_EPSILON)
     {
@@ -48,11 +173,7 @@ double inform_bin(double const *series, size_t n, int b, int *binned,
         INFORM_ERROR_RETURN(err, INFORM_EBIN, step);
     }
 
-    for (size_t i = 0; i < n; ++i)
-    {
-        binned[i] = (int) floor((series[i] - min) / step) - (series[i] == max);
-        assert(0 <= binned[i] && binned[i] < b);
-    }
+    bin_uniform(series, n, min, max, step, b, binned);
 
     return step;
 }
@@ -70,46 +191,265 @@ int inform_bin_step(double const *series, size_t n, double step, int *binned,
         INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
 
     double min, max;
-    double range = inform_range(series, n, &min, &max, err);
-    int b = (int) ceil(range / step);
+    column_range(series, n, &min, &max);
 
-    if (fmod(range,step) == 0.0) ++b;
+    return bin_step(series, n, min, max, step, binned);
+}
 
-    for (size_t i = 0; i < n; ++i)
+int inform_bin_bounds(double const *series, size_t n, double const *bounds,
+    size_t m, int *binned, inform_error *err)
+{
+    if (series == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    else if (n == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
+    else if (check_bounds(bounds, m, err))
+        return 0;
+    else if (binned == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+
+    return bin_bounds(series, n, bounds, m, binned);
+}
+
+static int *allocate_binned(double const *series, size_t n, size_t c,
+    int *binned, inform_error *err)
+{
+    if (series == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    else if (n == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NULL);
+    else if (c == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+
+    if (binned == NULL)
     {
-        binned[i] = (int) floor((series[i] - min) / step);
-        assert(0 <= binned[i] && binned[i] < b);
+        binned = malloc(n * c * sizeof(int));
+        if (binned == NULL)
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
+    return binned;
+}
 
-    return b;
+int *inform_bin_columns(double const *series, size_t n, size_t c, int b,
+    int *binned, double *steps, inform_error *err)
+{
+    if (b < 2)
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NULL);
+
+    bool allocate = (binned == NULL);
+    if ((binned = allocate_binned(series, n, c, binned, err)) == NULL)
+        return NULL;
+
+    int failed = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(|:failed)
+#endif
+    for (size_t j = 0; j < c; ++j)
+    {
+        double min, max;
+        column_range(series + n*j, n, &min, &max);
+        double step = (max - min) / b;
+        if (steps != NULL) steps[j] = step;
+        if (step <= 10.*DBL_EPSILON)
+        {
+            memset(binned + n*j, 0, n*sizeof(int));
+            failed = 1;
+        }
+        else
+        {
+            bin_uniform(series + n*j, n, min, max, step, b, binned + n*j);
+        }
+    }
+
+    if (failed)
+    {
+        if (allocate) free(binned);
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NULL);
+    }
+    return binned;
 }
 
-int inform_bin_bounds(double const *series, size_t n, double const *bounds,
-    size_t m, int *binned, inform_error *err)
+int *inform_bin_step_columns(double const *series, size_t n, size_t c,
+    double step, int *binned, int *b, inform_error *err)
+{
+    if (step <= 10.*DBL_EPSILON)
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NULL);
+
+    if ((binned = allocate_binned(series, n, c, binned, err)) == NULL)
+        return NULL;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t j = 0; j < c; ++j)
+    {
+        double min, max;
+        column_range(series + n*j, n, &min, &max);
+        int bj = bin_step(series + n*j, n, min, max, step, binned + n*j);
+        if (b != NULL) b[j] = bj;
+    }
+
+    return binned;
+}
+
+int *inform_bin_bounds_columns(double const *series, size_t n, size_t c,
+    double const *bounds, size_t m, int *binned, int *b, inform_error *err)
+{
+    if (check_bounds(bounds, m, err))
+        return NULL;
+
+    if ((binned = allocate_binned(series, n, c, binned, err)) == NULL)
+        return NULL;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (size_t j = 0; j < c; ++j)
+    {
+        int bj = bin_bounds(series + n*j, n, bounds, m, binned + n*j);
+        if (b != NULL) b[j] = bj;
+    }
+
+    return binned;
+}
+
+static void swap_doubles(double *a, double *b)
+{
+    double t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static double median_of_three(double a, double b, double c)
+{
+    if (a < b)
+    {
+        return (b < c) ? b : ((a < c) ? c : a);
+    }
+    return (a < c) ? a : ((b < c) ? c : b);
+}
+
+// rearrange xs[lo, hi) so that xs[k] is the value it would have were the
+// range sorted, with no larger value before it and no smaller value after it
+static void select_rank(double *xs, size_t lo, size_t hi, size_t k)
+{
+    while (hi - lo > 1)
+    {
+        double p = median_of_three(xs[lo], xs[lo + (hi - lo)/2], xs[hi - 1]);
+        size_t lt = lo, i = lo, gt = hi;
+        while (i < gt)
+        {
+            if (xs[i] < p)      swap_doubles(xs + lt++, xs + i++);
+            else if (p < xs[i]) swap_doubles(xs + i, xs + --gt);
+            else                ++i;
+        }
+        if (k < lt)       hi = lt;
+        else if (k >= gt) lo = gt;
+        else              return;
+    }
+}
+
+// place each of the (ascending) ranks at its sorted position by recursively
+// splitting the range about the median rank, in O(n log m) time
+static void select_ranks(double *xs, size_t lo, size_t hi,
+    size_t const *ranks, size_t m)
+{
+    while (m != 0)
+    {
+        size_t mid = m / 2, k = ranks[mid];
+        select_rank(xs, lo, hi, k);
+        select_ranks(xs, lo, k, ranks, mid);
+        lo = k + 1;
+        ranks += mid + 1;
+        m -= mid + 1;
+    }
+}
+
+static void bin_quantile(double const *series, size_t n, int b, double *xs,
+    size_t *ranks, int *binned, double *bounds, int *nbins)
+{
+    memcpy(xs, series, n * sizeof(double));
+    for (int i = 1; i < b; ++i)
+    {
+        ranks[i - 1] = ((size_t) i * n) / (size_t) b;
+    }
+    select_ranks(xs, 0, n, ranks, b - 1);
+    for (int i = 1; i < b; ++i)
+    {
+        bounds[i - 1] = xs[ranks[i - 1]];
+    }
+    *nbins = bin_bounds(series, n, bounds, b - 1, binned);
+}
+
+int inform_bin_quantile(double const *series, size_t n, int b, int *binned,
+    double *bounds, inform_error *err)
 {
     if (series == NULL)
         INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
     else if (n == 0)
         INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
-    else if (bounds == NULL || m == 0)
+    else if (b < 2 || (size_t) b > n)
         INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
     else if (binned == NULL)
         INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
 
-    int b = 0;
-    for (size_t i = 0; i < n; ++i)
+    double *xs = malloc((n + b) * sizeof(double));
+    size_t *ranks = malloc(b * sizeof(size_t));
+    if (xs == NULL || ranks == NULL)
     {
-        binned[i] = (int)m;
-        for (int x = 0; x < (int)m; ++x)
+        free(xs);
+        free(ranks);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
+    }
+
+    int nbins;
+    bin_quantile(series, n, b, xs, ranks, binned,
+        (bounds == NULL) ? xs + n : bounds, &nbins);
+
+    free(ranks);
+    free(xs);
+
+    return nbins;
+}
+
+int *inform_bin_quantile_columns(double const *series, size_t n, size_t c,
+    int b, int *binned, double *bounds, int *nbins, inform_error *err)
+{
+    if (b < 2 || (size_t) b > n)
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NULL);
+
+    bool allocate = (binned == NULL);
+    if ((binned = allocate_binned(series, n, c, binned, err)) == NULL)
+        return NULL;
+
+    int failed = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(|:failed)
+#endif
+    for (size_t j = 0; j < c; ++j)
+    {
+        double *xs = malloc((n + b) * sizeof(double));
+        size_t *ranks = malloc(b * sizeof(size_t));
+        if (xs == NULL || ranks == NULL)
         {
-            if (series[i] < bounds[x])
-            {
-                binned[i] = x;
-                break;
-            }
+            failed = 1;
         }
-        b = (b < binned[i]) ? binned[i] : b;
+        else
+        {
+            int bj;
+            double *bj_bounds = (bounds == NULL) ? xs + n : bounds + (b-1)*j;
+            bin_quantile(series + n*j, n, b, xs, ranks, binned + n*j,
+                bj_bounds, &bj);
+            if (nbins != NULL) nbins[j] = bj;
+        }
+        free(ranks);
+        free(xs);
     }
 
-    return b + 1;
+    if (failed)
+    {
+        if (allocate) free(binned);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return binned;
 }
@@ -1,14 +1,13 @@
 // Copyright 2016-2017 ELIFE. All rights reserved.
 // Use of this source code is governed by a MIT
 // license that can be found in the LICENSE file.
-#include <inform/error.h>
+#include <inform/utilities/black_boxing.h>
 #include <string.h>
 #include <math.h>
 
-#include <stdio.h>
-
 static bool check_arguments(int const *series, size_t l, size_t n, size_t m,
-    int const *b, size_t const *r, size_t const *s, inform_error *err)
+    int const *b, size_t const *r, size_t const *s, double max_bits,
+    inform_error *err)
 {
 
     if (series == NULL)
@@ -84,7 +83,7 @@ static bool check_arguments(int const *series, size_t l, size_t n, size_t m,
             bits += s[i] * log2(b[i]);
         }
     }
-    if (bits > 30.0)
+    if (bits > max_bits)
     {
         INFORM_ERROR_RETURN(err, INFORM_EENCODE, true);
     }
@@ -135,48 +134,105 @@ static void compute_lengths(size_t const *r, size_t const *s, size_t l,
 
 static void accumulate(int const *series, size_t l, size_t n, size_t m,
     int const *b, size_t const *r, size_t const *s, size_t max_r, size_t max_s,
-    int *box, inform_error *err)
+    int *box, uint64_t *codes, inform_error *err)
 {
-    int *data = malloc(2 * l * sizeof(int));
-    if (data == NULL) INFORM_ERROR_RETURN_VOID(err, INFORM_ENOMEM);
-
-    int *qs = data, *states = qs + l;
     size_t const w = m - max_r - max_s + 1;
-    for (size_t i = 0; i < n * w; ++i) box[i] = 0;
-    
-    for (size_t i = 0; i < l; ++i)
+    int failed = 0;
+
+    // each initial condition is boxed independently, and every variable's
+    // window is rolled forward by one shift-and-add per time step
+#ifdef _OPENMP
+    #pragma omp parallel reduction(|:failed)
+#endif
     {
+        uint64_t *qs = malloc(2 * l * sizeof(uint64_t));
+        uint64_t *states = (qs == NULL) ? NULL : qs + l;
+        failed = (qs == NULL);
+
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
         for (size_t j = 0; j < n; ++j)
         {
-            qs[i] = 1;
-            states[i] = 0;
-            for (size_t k = max_r - r[i]; k < max_r + s[i]; ++k)
+            if (qs == NULL) continue;
+
+            int const *x = series + m * j;
+            uint64_t code = 0;
+            for (size_t i = 0; i < l; ++i)
             {
-                qs[i] *= b[i];
-                states[i] *= b[i];
-                states[i] += series[k + m * (j + n * i)];
+                int const *xi = x + n * m * i;
+                qs[i] = 1;
+                states[i] = 0;
+                for (size_t k = max_r - r[i]; k < max_r + s[i]; ++k)
+                {
+                    qs[i] *= b[i];
+                    states[i] = states[i] * b[i] + xi[k];
+                }
+                code = code * qs[i] + states[i];
             }
-            box[w * j] *= qs[i];
-            box[w * j] += states[i];
+            if (box != NULL) box[w * j] = (int) code;
+            else             codes[w * j] = code;
 
             for (size_t k = max_r; k < m - max_s; ++k)
             {
-                states[i] *= b[i];
-                states[i] -= series[k - r[i] + m * (j + n * i)] * qs[i];
-                states[i] += series[k + s[i] + m * (j + n * i)];
-                box[k - max_r + 1 + w * j] *= qs[i];
-                box[k - max_r + 1 + w * j] += states[i];
+                code = 0;
+                for (size_t i = 0; i < l; ++i)
+                {
+                    int const *xi = x + n * m * i;
+                    states[i] = states[i] * b[i] - xi[k - r[i]] * qs[i] +
+                        xi[k + s[i]];
+                    code = code * qs[i] + states[i];
+                }
+                if (box != NULL) box[k - max_r + 1 + w * j] = (int) code;
+                else             codes[k - max_r + 1 + w * j] = code;
             }
         }
+
+        free(qs);
     }
-        
+
+    if (failed)
+    {
+        INFORM_ERROR(err, INFORM_ENOMEM);
+    }
+}
+
+static void black_box(int const *series, size_t l, size_t n, size_t m,
+    int const *b, size_t const *r, size_t const *s, size_t max_r, size_t max_s,
+    int *box, uint64_t *codes, inform_error *err)
+{
+    size_t *data = calloc(2 * l, sizeof(size_t));
+    if (data == NULL)
+    {
+        INFORM_ERROR_RETURN_VOID(err, INFORM_ENOMEM);
+    }
+
+    size_t *history = data;
+    if (r == NULL)
+    {
+        for (size_t i = 0; i < l; ++i) history[i] = 1;
+    }
+    else
+    {
+        memcpy(history, r, l * sizeof(size_t));
+    }
+
+    size_t *future = data + l;
+    if (s != NULL)
+    {
+        memcpy(future, s, l * sizeof(size_t));
+    }
+
+    accumulate(series, l, n, m, b, history, future, max_r, max_s, box, codes,
+        err);
+
     free(data);
 }
 
 int* inform_black_box(int const *series, size_t l, size_t n, size_t m,
     int const *b, size_t const *r, size_t const *s, int *box, inform_error *err)
 {
-    if (check_arguments(series, l, n, m, b, r, s, err))
+    if (check_arguments(series, l, n, m, b, r, s, 30.0, err))
     {
         return NULL;
     }
@@ -193,37 +249,44 @@ int* inform_black_box(int const *series, size_t l, size_t n, size_t m,
         }
     }
 
-    size_t *data = calloc(2 * l, sizeof(size_t));
-    if (data == NULL)
+    black_box(series, l, n, m, b, r, s, max_r, max_s, box, NULL, err);
+
+    if (inform_failed(err))
     {
         if (allocate) free(box);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        box = NULL;
     }
+    return box;
+}
 
-    size_t *history = data;
-    if (r == NULL)
-    {
-        for (size_t i = 0; i < l; ++i) history[i] = 1;
-    }
-    else
+uint64_t *inform_black_box_codes(int const *series, size_t l, size_t n,
+    size_t m, int const *b, size_t const *r, size_t const *s, uint64_t *box,
+    inform_error *err)
+{
+    if (check_arguments(series, l, n, m, b, r, s, 63.0, err))
     {
-        memcpy(history, r, l * sizeof(size_t));
+        return NULL;
     }
+    size_t max_r, max_s;
+    compute_lengths(r, s, l, &max_r, &max_s);
 
-    size_t *future = data + l;
-    if (s != NULL)
+    bool allocate = (box == NULL);
+    if (allocate)
     {
-        memcpy(future, s, l * sizeof(size_t));
+        box = malloc(n * (m - max_r - max_s + 1) * sizeof(uint64_t));
+        if (box == NULL)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
     }
 
-    accumulate(series, l, n, m, b, history, future, max_r, max_s, box, err);
+    black_box(series, l, n, m, b, r, s, max_r, max_s, NULL, box, err);
 
     if (inform_failed(err))
     {
         if (allocate) free(box);
         box = NULL;
     }
-    free(data);
     return box;
 }
 
@@ -237,7 +300,7 @@ static int compare_ints(void const *x, void const *y)
 int *inform_black_box_parts(int const *series, size_t l, size_t n, int const *b,
     size_t const *parts, size_t nparts, int *box, inform_error *err)
 {
-    if (check_arguments(series, l, 1, n, b, NULL, NULL, err))
+    if (check_arguments(series, l, 1, n, b, NULL, NULL, 30.0, err))
     {
         return NULL;
     }
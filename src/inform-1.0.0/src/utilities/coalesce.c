@@ -2,8 +2,20 @@
 // Use of this source code is governed by a MIT
 // license that can be found in the LICENSE file.
 #include <inform/utilities/coalesce.h>
+#include <stdint.h>
 #include <string.h>
 
+/// the largest value range (relative to the length of the series) for which
+/// a direct lookup table is used rather than a hash map
+#define COALESCE_TABLE_FACTOR 4
+#define COALESCE_TABLE_SLACK  4096
+
+typedef struct coalesce_entry
+{
+    int key;
+    int rank;
+} coalesce_entry;
+
 static int compare_ints(void const *a, void const *b)
 {
     int x = *(int const*)a;
@@ -13,6 +25,105 @@ static int compare_ints(void const *a, void const *b)
     return 0;
 }
 
+// the states are ranked by marking each value present in a table spanning
+// the range of the series, and taking a running count over the table
+static int coalesce_table(int const *series, size_t n, int min, size_t range,
+    int *coal)
+{
+    int *table = calloc(range, sizeof(int));
+    if (table == NULL)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        table[(size_t) ((int64_t) series[i] - min)] = 1;
+    }
+    int b = 0;
+    for (size_t j = 0; j < range; ++j)
+    {
+        if (table[j]) table[j] = b++;
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        coal[i] = table[(size_t) ((int64_t) series[i] - min)];
+    }
+    free(table);
+    return b;
+}
+
+inline static size_t hash_int(int x, size_t mask)
+{
+    return (size_t) (((uint32_t) x * 0x9E3779B1u) ^ ((uint32_t) x >> 16)) & mask;
+}
+
+// the distinct states are gathered with an open-addressing hash map, so only
+// they (rather than the whole series) need to be sorted to be ranked
+static int coalesce_hash(int const *series, size_t n, int *coal)
+{
+    size_t cap = 16;
+    while (cap < 2 * n) cap <<= 1;
+    size_t const mask = cap - 1;
+
+    coalesce_entry *map = malloc(cap * sizeof(coalesce_entry));
+    int *keys = malloc(n * sizeof(int));
+    if (map == NULL || keys == NULL)
+    {
+        free(keys);
+        free(map);
+        return -1;
+    }
+    for (size_t j = 0; j < cap; ++j) map[j].rank = -1;
+
+    size_t b = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t j = hash_int(series[i], mask);
+        while (map[j].rank != -1 && map[j].key != series[i]) j = (j + 1) & mask;
+        if (map[j].rank == -1)
+        {
+            map[j].key = series[i];
+            map[j].rank = 0;
+            keys[b++] = series[i];
+        }
+    }
+
+    qsort(keys, b, sizeof(int), compare_ints);
+    for (size_t r = 0; r < b; ++r)
+    {
+        size_t j = hash_int(keys[r], mask);
+        while (map[j].key != keys[r]) j = (j + 1) & mask;
+        map[j].rank = (int) r;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t j = hash_int(series[i], mask);
+        while (map[j].key != series[i]) j = (j + 1) & mask;
+        coal[i] = map[j].rank;
+    }
+
+    free(keys);
+    free(map);
+    return (int) b;
+}
+
+static int coalesce(int const *series, size_t n, int *coal)
+{
+    int min = series[0], max = series[0];
+    for (size_t i = 1; i < n; ++i)
+    {
+        min = (series[i] < min) ? series[i] : min;
+        max = (max < series[i]) ? series[i] : max;
+    }
+    size_t const range = (size_t) ((int64_t) max - min) + 1;
+    if (range <= COALESCE_TABLE_FACTOR * n + COALESCE_TABLE_SLACK)
+    {
+        return coalesce_table(series, n, min, range, coal);
+    }
+    return coalesce_hash(series, n, coal);
+}
+
 int inform_coalesce(int const *series, size_t n, int *coal, inform_error *err)
 {
     if (series == NULL)
@@ -22,43 +133,135 @@ int inform_coalesce(int const *series, size_t n, int *coal, inform_error *err)
     else if (coal == NULL)
         INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
 
-    int *tmp = malloc(n * sizeof(int));
-    if (tmp == NULL)
+    int b = coalesce(series, n, coal);
+    if (b < 0)
     {
         INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
     }
-    memcpy(tmp, series, n * sizeof(int));
-    qsort(tmp, n, sizeof(int), compare_ints);
-    int b = 1;
-    for (size_t i = 1; i < n; ++i)
+    return b;
+}
+
+int *inform_coalesce_columns(int const *series, size_t n, size_t c,
+    int *coal, int *b, inform_error *err)
+{
+    if (series == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    else if (n == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NULL);
+    else if (c == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, NULL);
+
+    bool allocate = (coal == NULL);
+    if (allocate)
     {
-        if (tmp[i] != tmp[i-1]) ++b;
+        coal = malloc(n * c * sizeof(int));
+        if (coal == NULL)
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
     }
 
-    int *map = malloc(b * sizeof(int));
-    if (map == NULL)
+    int failed = 0;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) reduction(|:failed)
+#endif
+    for (size_t j = 0; j < c; ++j)
     {
-        free(tmp);
-        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
+        int bj = coalesce(series + n*j, n, coal + n*j);
+        if (bj < 0) failed = 1;
+        if (b != NULL) b[j] = bj;
     }
-    map[0] = tmp[0];
-    for (size_t i = 1, j = 1; i < n; ++i)
+
+    if (failed)
+    {
+        if (allocate) free(coal);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return coal;
+}
+
+int inform_coalesce_joint(int const *series, size_t n, size_t c, int *coal,
+    inform_error *err)
+{
+    if (c == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ENOSOURCES, 0);
+    return inform_coalesce(series, n * c, coal, err);
+}
+
+typedef struct code_entry
+{
+    uint64_t key;
+    int rank;
+} code_entry;
+
+static int compare_codes(void const *a, void const *b)
+{
+    uint64_t x = *(uint64_t const*)a;
+    uint64_t y = *(uint64_t const*)b;
+    return (x > y) - (x < y);
+}
+
+inline static size_t hash_code(uint64_t x, size_t mask)
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return (size_t) x & mask;
+}
+
+int inform_coalesce_codes(uint64_t const *series, size_t n, int *coal,
+    inform_error *err)
+{
+    if (series == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    else if (n == 0)
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
+    else if (coal == NULL)
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    else if (n > INT32_MAX)
+        INFORM_ERROR_RETURN(err, INFORM_EENCODE, 0);
+
+    size_t cap = 16;
+    while (cap < 2 * n) cap <<= 1;
+    size_t const mask = cap - 1;
+
+    code_entry *map = malloc(cap * sizeof(code_entry));
+    uint64_t *keys = malloc(n * sizeof(uint64_t));
+    if (map == NULL || keys == NULL)
     {
-        if (tmp[i] != tmp[i-1]) map[j++] = tmp[i];
+        free(keys);
+        free(map);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
     }
-    free(tmp);
+    for (size_t j = 0; j < cap; ++j) map[j].rank = -1;
 
+    size_t b = 0;
     for (size_t i = 0; i < n; ++i)
     {
-        int *x = bsearch(series + i, map, b, sizeof(int), compare_ints);
-        if (x == NULL)
+        size_t j = hash_code(series[i], mask);
+        while (map[j].rank != -1 && map[j].key != series[i]) j = (j + 1) & mask;
+        if (map[j].rank == -1)
         {
-            free(map);
-            INFORM_ERROR_RETURN(err, INFORM_EBIN, 0);
+            map[j].key = series[i];
+            map[j].rank = 0;
+            keys[b++] = series[i];
         }
-        coal[i] = (int) (x - map);
     }
 
+    qsort(keys, b, sizeof(uint64_t), compare_codes);
+    for (size_t r = 0; r < b; ++r)
+    {
+        size_t j = hash_code(keys[r], mask);
+        while (map[j].key != keys[r]) j = (j + 1) & mask;
+        map[j].rank = (int) r;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t j = hash_code(series[i], mask);
+        while (map[j].key != series[i]) j = (j + 1) & mask;
+        coal[i] = map[j].rank;
+    }
+
+    free(keys);
     free(map);
-    return b;
-}
\ No newline at end of file
+    return (int) b;
+}
@@ -0,0 +1,164 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/utilities/counting.h>
+#include <math.h>
+#include <string.h>
+
+#define COUNTING_RADIX_BITS 8
+#define COUNTING_RADIX (1 << COUNTING_RADIX_BITS)
+
+// Sort the codes (and the positions they came from, if `index` is not NULL)
+// with a least-significant-digit radix sort, skipping the digits above the
+// largest code. The sorted codes end up in `keys`.
+static void radix_sort(uint64_t *keys, uint32_t *index, size_t n,
+    uint64_t *key_buffer, uint32_t *index_buffer)
+{
+    uint64_t max = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        max = (max < keys[i]) ? keys[i] : max;
+    }
+
+    size_t offsets[COUNTING_RADIX];
+    for (unsigned shift = 0; shift < 64 && (max >> shift) != 0;
+        shift += COUNTING_RADIX_BITS)
+    {
+        memset(offsets, 0, sizeof(offsets));
+        for (size_t i = 0; i < n; ++i)
+        {
+            offsets[(keys[i] >> shift) & (COUNTING_RADIX - 1)]++;
+        }
+        for (size_t d = 0, total = 0; d < COUNTING_RADIX; ++d)
+        {
+            size_t const count = offsets[d];
+            offsets[d] = total;
+            total += count;
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t const digit = (keys[i] >> shift) & (COUNTING_RADIX - 1);
+            size_t const j = offsets[digit]++;
+            key_buffer[j] = keys[i];
+            if (index != NULL) index_buffer[j] = index[i];
+        }
+        memcpy(keys, key_buffer, n * sizeof(uint64_t));
+        if (index != NULL) memcpy(index, index_buffer, n * sizeof(uint32_t));
+    }
+}
+
+size_t inform_count_codes(uint64_t const *codes, size_t n, uint64_t *states,
+    uint32_t *counts, uint32_t *local, inform_error *err)
+{
+    if (codes == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    }
+    else if (n == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
+    }
+    else if (UINT32_MAX < n)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, 0);
+    }
+
+    uint64_t *keys = malloc(2 * n * sizeof(uint64_t));
+    uint32_t *index = (local == NULL) ? NULL : malloc(2 * n * sizeof(uint32_t));
+    if (keys == NULL || (local != NULL && index == NULL))
+    {
+        free(index);
+        free(keys);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
+    }
+
+    size_t const distinct = inform_count_codes_buffered(codes, n, states,
+        counts, local, keys, index, err);
+
+    free(index);
+    free(keys);
+    return distinct;
+}
+
+size_t inform_count_codes_buffered(uint64_t const *codes, size_t n,
+    uint64_t *states, uint32_t *counts, uint32_t *local, uint64_t *keys,
+    uint32_t *index, inform_error *err)
+{
+    if (codes == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, 0);
+    }
+    else if (n == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, 0);
+    }
+    else if (UINT32_MAX < n)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, 0);
+    }
+    else if (keys == NULL || (local != NULL && index == NULL))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, 0);
+    }
+
+    memcpy(keys, codes, n * sizeof(uint64_t));
+    if (local != NULL)
+    {
+        for (size_t i = 0; i < n; ++i) index[i] = (uint32_t) i;
+    }
+    else
+    {
+        index = NULL;
+    }
+
+    radix_sort(keys, index, n, keys + n, (index == NULL) ? NULL : index + n);
+
+    size_t distinct = 0;
+    for (size_t start = 0, end = 0; start < n; start = end, ++distinct)
+    {
+        while (end < n && keys[end] == keys[start]) ++end;
+        if (states != NULL) states[distinct] = keys[start];
+        if (counts != NULL) counts[distinct] = (uint32_t) (end - start);
+        if (local != NULL)
+        {
+            for (size_t i = start; i < end; ++i)
+            {
+                local[index[i]] = (uint32_t) (end - start);
+            }
+        }
+    }
+    return distinct;
+}
+
+double inform_code_entropy(uint64_t const *codes, size_t n, inform_error *err)
+{
+    if (codes == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NAN);
+    }
+    else if (n == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ESHORTSERIES, NAN);
+    }
+
+    uint32_t *counts = malloc(n * sizeof(uint32_t));
+    if (counts == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NAN);
+    }
+    size_t const distinct = inform_count_codes(codes, n, NULL, counts, NULL,
+        err);
+    if (inform_failed(err))
+    {
+        free(counts);
+        return NAN;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < distinct; ++i)
+    {
+        sum += counts[i] * log2(counts[i]);
+    }
+    free(counts);
+    return log2((double) n) - sum / n;
+}
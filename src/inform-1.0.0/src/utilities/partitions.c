@@ -5,6 +5,28 @@
 #include <stdlib.h>
 #include <inform/utilities/partitions.h>
 
+/// the largest set whose number of partitionings fits in 64 bits
+#define PARTITIONS_MAX_SIZE 25
+
+// completions[r][m] is the number of ways to extend a partitioning prefix with
+// m blocks by r further elements; only the entries with r + m <= size are
+// filled, and these are at most the Bell number of size.
+static void count_completions(size_t size,
+    uint64_t completions[PARTITIONS_MAX_SIZE][PARTITIONS_MAX_SIZE + 1])
+{
+    for (size_t m = 1; m <= size; ++m)
+    {
+        completions[0][m] = 1;
+    }
+    for (size_t r = 1; r < size; ++r)
+    {
+        for (size_t m = 1; r + m <= size; ++m)
+        {
+            completions[r][m] = m * completions[r-1][m] + completions[r-1][m+1];
+        }
+    }
+}
+
 size_t *inform_first_partitioning(size_t size)
 {
     return (size > 0) ? calloc(size, sizeof(size_t)) : NULL;
@@ -41,4 +63,96 @@ size_t inform_next_partitioning(size_t *xs, size_t size)
         }
     }
     return n;
-}
\ No newline at end of file
+}
+
+uint64_t inform_bell_number(size_t size)
+{
+    if (size == 0)
+    {
+        return 1;
+    }
+    else if (size > PARTITIONS_MAX_SIZE)
+    {
+        return 0;
+    }
+    uint64_t completions[PARTITIONS_MAX_SIZE][PARTITIONS_MAX_SIZE + 1];
+    count_completions(size, completions);
+    return completions[size-1][1];
+}
+
+uint64_t inform_rank_partitioning(size_t const *xs, size_t size)
+{
+    if (xs == NULL || size == 0 || size > PARTITIONS_MAX_SIZE)
+    {
+        return 0;
+    }
+    uint64_t completions[PARTITIONS_MAX_SIZE][PARTITIONS_MAX_SIZE + 1];
+    count_completions(size, completions);
+
+    // each element could have been any of the m blocks before it, or a new one
+    uint64_t rank = 0;
+    size_t m = 1;
+    for (size_t i = 1; i < size; ++i)
+    {
+        rank += xs[i] * completions[size-1-i][m];
+        m = (xs[i] + 1 > m) ? xs[i] + 1 : m;
+    }
+    return rank;
+}
+
+size_t inform_unrank_partitioning(uint64_t rank, size_t size, size_t *xs,
+    size_t *blocks)
+{
+    if (xs == NULL || size == 0 || size > PARTITIONS_MAX_SIZE)
+    {
+        return 0;
+    }
+    uint64_t completions[PARTITIONS_MAX_SIZE][PARTITIONS_MAX_SIZE + 1];
+    count_completions(size, completions);
+    if (rank >= completions[size-1][1])
+    {
+        return 0;
+    }
+
+    size_t m = 1;
+    xs[0] = 0;
+    if (blocks) blocks[0] = 1;
+    for (size_t i = 1; i < size; ++i)
+    {
+        uint64_t const c = completions[size-1-i][m];
+        if (rank < m * c)
+        {
+            xs[i] = rank / c;
+            rank %= c;
+        }
+        else
+        {
+            xs[i] = m;
+            rank -= m * c;
+            m += 1;
+        }
+        if (blocks) blocks[i] = m;
+    }
+    return m;
+}
+
+size_t inform_next_partitioning_blocks(size_t *xs, size_t *blocks,
+    size_t size)
+{
+    // the last element which may join a later block of its prefix
+    for (size_t i = size; i-- > 1;)
+    {
+        if (xs[i] < blocks[i-1])
+        {
+            xs[i] += 1;
+            blocks[i] = (xs[i] + 1 > blocks[i-1]) ? xs[i] + 1 : blocks[i-1];
+            for (size_t j = i + 1; j < size; ++j)
+            {
+                xs[j] = 0;
+                blocks[j] = blocks[i];
+            }
+            return blocks[size-1];
+        }
+    }
+    return 0;
+}
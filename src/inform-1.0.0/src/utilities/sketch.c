@@ -0,0 +1,380 @@
+// Copyright 2016-2017 ELIFE. All rights reserved.
+// Use of this source code is governed by a MIT
+// license that can be found in the LICENSE file.
+#include <inform/utilities/sketch.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// the smallest capacity of any compactor
+#define SKETCH_MIN_CAPACITY 8
+/// the largest number of levels (each level doubles the weight of its items)
+#define SKETCH_MAX_LEVELS 64
+
+typedef struct weighted_item
+{
+    double value;
+    uint64_t weight;
+} weighted_item;
+
+static int compare_doubles(void const *x, void const *y)
+{
+    double const a = *(double const *)x, b = *(double const *)y;
+    return (a > b) - (a < b);
+}
+
+static int compare_items(void const *x, void const *y)
+{
+    return compare_doubles(&((weighted_item const *)x)->value,
+        &((weighted_item const *)y)->value);
+}
+
+static size_t level_capacity(size_t k, size_t levels, size_t h)
+{
+    double cap = floor(k * pow(2.0 / 3.0, (double)(levels - 1 - h)));
+    return (cap < SKETCH_MIN_CAPACITY) ? SKETCH_MIN_CAPACITY : (size_t) cap;
+}
+
+// a stateless coin flip so that a sketch can be rebuilt from its items alone
+static size_t compaction_offset(uint64_t counts, size_t h)
+{
+    uint64_t z = counts + 0x9E3779B97F4A7C15ULL * (h + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (size_t)((z ^ (z >> 31)) & 1);
+}
+
+static bool add_level(inform_qsketch *sketch)
+{
+    size_t const h = sketch->levels;
+    if (h == SKETCH_MAX_LEVELS)
+    {
+        return false;
+    }
+    double **items = realloc(sketch->items, (h + 1) * sizeof(double*));
+    if (items == NULL) return false;
+    sketch->items = items;
+    size_t *sizes = realloc(sketch->sizes, (h + 1) * sizeof(size_t));
+    if (sizes == NULL) return false;
+    sketch->sizes = sizes;
+    size_t *capacities = realloc(sketch->capacities, (h + 1) * sizeof(size_t));
+    if (capacities == NULL) return false;
+    sketch->capacities = capacities;
+
+    sketch->items[h] = NULL;
+    sketch->sizes[h] = 0;
+    sketch->capacities[h] = 0;
+    sketch->levels = h + 1;
+    return true;
+}
+
+static bool push(inform_qsketch *sketch, size_t h, double x)
+{
+    while (sketch->levels <= h)
+    {
+        if (!add_level(sketch)) return false;
+    }
+    if (sketch->sizes[h] == sketch->capacities[h])
+    {
+        size_t cap = 2 * sketch->capacities[h];
+        if (cap < SKETCH_MIN_CAPACITY) cap = SKETCH_MIN_CAPACITY;
+        double *items = realloc(sketch->items[h], cap * sizeof(double));
+        if (items == NULL) return false;
+        sketch->items[h] = items;
+        sketch->capacities[h] = cap;
+    }
+    sketch->items[h][sketch->sizes[h]++] = x;
+    return true;
+}
+
+static bool compact(inform_qsketch *sketch, size_t h)
+{
+    double *items = sketch->items[h];
+    size_t const size = sketch->sizes[h];
+    qsort(items, size, sizeof(double), compare_doubles);
+
+    // pair off the items, promoting one of each pair; an odd item stays put
+    size_t const paired = size - (size & 1);
+    for (size_t i = compaction_offset(sketch->counts, h); i < paired; i += 2)
+    {
+        if (!push(sketch, h + 1, items[i]))
+        {
+            return false;
+        }
+    }
+    // push may have reallocated the array of levels, but not this level
+    if (size & 1)
+    {
+        sketch->items[h][0] = sketch->items[h][size - 1];
+    }
+    sketch->sizes[h] = size & 1;
+    return true;
+}
+
+static bool compress(inform_qsketch *sketch)
+{
+    bool compacted = true;
+    while (compacted)
+    {
+        compacted = false;
+        for (size_t h = 0; h < sketch->levels; ++h)
+        {
+            size_t cap = level_capacity(sketch->k, sketch->levels, h);
+            if (sketch->sizes[h] >= cap)
+            {
+                if (!compact(sketch, h)) return false;
+                compacted = true;
+            }
+        }
+    }
+    return true;
+}
+
+inform_qsketch *inform_qsketch_alloc(size_t k)
+{
+    if (k < SKETCH_MIN_CAPACITY)
+    {
+        return NULL;
+    }
+    inform_qsketch *sketch = malloc(sizeof(inform_qsketch));
+    if (sketch == NULL)
+    {
+        return NULL;
+    }
+    sketch->k = k;
+    sketch->counts = 0;
+    sketch->levels = 0;
+    sketch->items = NULL;
+    sketch->sizes = NULL;
+    sketch->capacities = NULL;
+    if (!add_level(sketch))
+    {
+        inform_qsketch_free(sketch);
+        return NULL;
+    }
+    return sketch;
+}
+
+void inform_qsketch_free(inform_qsketch *sketch)
+{
+    if (sketch != NULL)
+    {
+        for (size_t h = 0; h < sketch->levels; ++h)
+        {
+            free(sketch->items[h]);
+        }
+        free(sketch->items);
+        free(sketch->sizes);
+        free(sketch->capacities);
+        free(sketch);
+    }
+}
+
+size_t inform_qsketch_max_size(size_t k)
+{
+    // the capacities decay geometrically from k, with a floor on each level
+    return 3 * k + SKETCH_MIN_CAPACITY * SKETCH_MAX_LEVELS;
+}
+
+size_t inform_qsketch_size(inform_qsketch const *sketch)
+{
+    size_t size = 0;
+    if (sketch != NULL)
+    {
+        for (size_t h = 0; h < sketch->levels; ++h)
+        {
+            size += sketch->sizes[h];
+        }
+    }
+    return size;
+}
+
+inform_qsketch *inform_qsketch_insert(inform_qsketch *sketch, double x,
+    size_t level, inform_error *err)
+{
+    if (sketch == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EFAULT, NULL);
+    }
+    else if (level >= SKETCH_MAX_LEVELS || isnan(x))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+    if (!push(sketch, level, x))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    sketch->counts += (uint64_t)1 << level;
+    return sketch;
+}
+
+inform_qsketch *inform_qsketch_update(inform_qsketch *sketch,
+    double const *series, size_t n, inform_error *err)
+{
+    if (sketch == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EFAULT, NULL);
+    }
+    else if (series == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ETIMESERIES, NULL);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (isnan(series[i]))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+        }
+        if (!push(sketch, 0, series[i]))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+        sketch->counts += 1;
+        if (sketch->sizes[0] >= level_capacity(sketch->k, sketch->levels, 0)
+            && !compress(sketch))
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+    return sketch;
+}
+
+inform_qsketch *inform_qsketch_merge(inform_qsketch *sketch,
+    inform_qsketch const *other, inform_error *err)
+{
+    if (sketch == NULL || other == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EFAULT, NULL);
+    }
+    else if (sketch->k != other->k)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+    }
+
+    for (size_t h = 0; h < other->levels; ++h)
+    {
+        for (size_t i = 0; i < other->sizes[h]; ++i)
+        {
+            if (!push(sketch, h, other->items[h][i]))
+            {
+                INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+            }
+        }
+    }
+    sketch->counts += other->counts;
+    if (!compress(sketch))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    return sketch;
+}
+
+static weighted_item *sorted_items(inform_qsketch const *sketch,
+    size_t *size, inform_error *err)
+{
+    if (sketch == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EFAULT, NULL);
+    }
+    else if (sketch->counts == 0)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EDIST, NULL);
+    }
+
+    *size = inform_qsketch_size(sketch);
+    weighted_item *items = malloc(*size * sizeof(weighted_item));
+    if (items == NULL)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    size_t j = 0;
+    for (size_t h = 0; h < sketch->levels; ++h)
+    {
+        for (size_t i = 0; i < sketch->sizes[h]; ++i, ++j)
+        {
+            items[j].value = sketch->items[h][i];
+            items[j].weight = (uint64_t)1 << h;
+        }
+    }
+    qsort(items, *size, sizeof(weighted_item), compare_items);
+    return items;
+}
+
+// the smallest retained item whose cumulative weight exceeds `rank`
+static double item_at_rank(weighted_item const *items, size_t size,
+    uint64_t rank, size_t *start, uint64_t *cumulative)
+{
+    size_t i = *start;
+    uint64_t c = *cumulative;
+    while (i + 1 < size && c + items[i].weight <= rank)
+    {
+        c += items[i++].weight;
+    }
+    *start = i;
+    *cumulative = c;
+    return items[i].value;
+}
+
+double inform_qsketch_quantile(inform_qsketch const *sketch, double q,
+    inform_error *err)
+{
+    if (!(0.0 <= q && q <= 1.0))
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NAN);
+    }
+
+    size_t size;
+    weighted_item *items = sorted_items(sketch, &size, err);
+    if (items == NULL)
+    {
+        return NAN;
+    }
+
+    uint64_t rank = (uint64_t) floor(q * sketch->counts);
+    if (rank >= sketch->counts) rank = sketch->counts - 1;
+    size_t start = 0;
+    uint64_t cumulative = 0;
+    double x = item_at_rank(items, size, rank, &start, &cumulative);
+
+    free(items);
+    return x;
+}
+
+double *inform_qsketch_bounds(inform_qsketch const *sketch, int b,
+    double *bounds, inform_error *err)
+{
+    if (b < 2)
+    {
+        INFORM_ERROR_RETURN(err, INFORM_EBIN, NULL);
+    }
+
+    size_t size;
+    weighted_item *items = sorted_items(sketch, &size, err);
+    if (items == NULL)
+    {
+        return NULL;
+    }
+
+    if (bounds == NULL)
+    {
+        bounds = malloc((b - 1) * sizeof(double));
+        if (bounds == NULL)
+        {
+            free(items);
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        }
+    }
+
+    // the ranks are increasing, so a single sweep over the items suffices
+    size_t start = 0;
+    uint64_t cumulative = 0;
+    for (int i = 1; i < b; ++i)
+    {
+        uint64_t rank = (uint64_t) i * sketch->counts / (uint64_t) b;
+        bounds[i - 1] = item_at_rank(items, size, rank, &start, &cumulative);
+    }
+
+    free(items);
+    return bounds;
+}
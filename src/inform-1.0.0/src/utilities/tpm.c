@@ -1,7 +1,9 @@
 // Copyright 2016-2017 ELIFE. All rights reserved.
 // Use of this source code is governed by a MIT
 // license that can be found in the LICENSE file.
-#include <inform/error.h>
+#include <inform/utilities/tpm.h>
+#include <math.h>
+#include <string.h>
 
 inline static bool check_arguments(int const *series, size_t n, size_t m, int b, 
     inform_error *err)
@@ -85,3 +87,307 @@ double *inform_tpm(int const *series, size_t n, size_t m, int b, double *tpm,
 
     return tpm;
 }
+
+void inform_sparse_tpm_free(inform_sparse_tpm *tpm)
+{
+    if (tpm != NULL)
+    {
+        free(tpm->values);
+        free(tpm->columns);
+        free(tpm->offsets);
+        free(tpm);
+    }
+}
+
+inform_sparse_tpm *inform_tpm_sparse(int const *series, size_t n, size_t m,
+    int b, inform_error *err)
+{
+    if (check_arguments(series, n, m, b, err))
+        return NULL;
+
+    size_t const N = n * (m - 1);
+    inform_sparse_tpm *tpm = malloc(sizeof(inform_sparse_tpm));
+    size_t *counts = calloc(b + 1, sizeof(size_t));
+    size_t *sorted = malloc(2 * N * sizeof(size_t));
+    if (tpm != NULL)
+    {
+        tpm->size = b;
+        tpm->nnz = 0;
+        tpm->offsets = calloc(b + 1, sizeof(size_t));
+        tpm->columns = malloc(N * sizeof(size_t));
+        tpm->values = malloc(N * sizeof(double));
+    }
+    if (tpm == NULL || counts == NULL || sorted == NULL ||
+        tpm->offsets == NULL || tpm->columns == NULL || tpm->values == NULL)
+    {
+        free(sorted);
+        free(counts);
+        inform_sparse_tpm_free(tpm);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+
+    // Two stable counting sorts of the transitions (by successor, then by
+    // predecessor) leave each row's successors in increasing order. Each
+    // transition is identified by the index of its predecessor.
+    size_t *by_future = sorted, *by_current = sorted + N;
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < m - 1; ++j)
+            counts[series[m * i + j + 1] + 1]++;
+    for (int s = 0; s < b; ++s)
+        counts[s + 1] += counts[s];
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < m - 1; ++j)
+            by_future[counts[series[m * i + j + 1]]++] = m * i + j;
+
+    size_t *offsets = tpm->offsets;
+    for (size_t t = 0; t < N; ++t)
+        offsets[series[by_future[t]] + 1]++;
+    for (int s = 0; s < b; ++s)
+        offsets[s + 1] += offsets[s];
+    memcpy(counts, offsets, b * sizeof(size_t));
+    for (size_t t = 0; t < N; ++t)
+        by_current[counts[series[by_future[t]]]++] = by_future[t];
+
+    // merge repeated transitions, normalising each row as it is completed
+    size_t nnz = 0;
+    for (int s = 0; s < b; ++s)
+    {
+        size_t const start = nnz, first = offsets[s], last = offsets[s + 1];
+        for (size_t t = first; t < last; ++t)
+        {
+            size_t const future = series[by_current[t] + 1];
+            if (nnz == start || tpm->columns[nnz - 1] != future)
+            {
+                tpm->columns[nnz] = future;
+                tpm->values[nnz++] = 0.0;
+            }
+            tpm->values[nnz - 1] += 1.0;
+        }
+        if (last == first)
+        {
+            INFORM_ERROR(err, INFORM_ETPMROW);
+        }
+        for (size_t k = start; k < nnz; ++k)
+        {
+            tpm->values[k] /= (last - first);
+        }
+        offsets[s] = start;
+    }
+    offsets[b] = nnz;
+    tpm->nnz = nnz;
+
+    free(sorted);
+    free(counts);
+
+    return tpm;
+}
+
+/// the largest number of codes that are counted directly, rather than sorted
+#define TPM_K_MAX_DIRECT ((uint64_t) 1 << 24)
+
+void inform_history_tpm_free(inform_history_tpm *tpm)
+{
+    if (tpm != NULL)
+    {
+        free(tpm->values);
+        free(tpm->counts);
+        free(tpm->futures);
+        free(tpm->offsets);
+        free(tpm->histories);
+        free(tpm);
+    }
+}
+
+static int compare_codes(void const *x, void const *y)
+{
+    uint64_t const a = *(uint64_t const *)x, b = *(uint64_t const *)y;
+    return (a > b) - (a < b);
+}
+
+// Count the distinct codes of `N` transitions, leaving them in increasing
+// order in `codes` with their counts in `counts`.
+static size_t count_codes(uint64_t *codes, size_t N, uint64_t states,
+    uint64_t *counts, inform_error *err)
+{
+    size_t distinct = 0;
+    if (states <= TPM_K_MAX_DIRECT && states <= 4 * (uint64_t) N)
+    {
+        uint64_t *histogram = calloc(states, sizeof(uint64_t));
+        if (histogram == NULL)
+        {
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, 0);
+        }
+        for (size_t t = 0; t < N; ++t) histogram[codes[t]]++;
+        for (uint64_t c = 0; c < states; ++c)
+        {
+            if (histogram[c] != 0)
+            {
+                codes[distinct] = c;
+                counts[distinct++] = histogram[c];
+            }
+        }
+        free(histogram);
+    }
+    else
+    {
+        qsort(codes, N, sizeof(uint64_t), compare_codes);
+        for (size_t t = 0; t < N; ++t)
+        {
+            if (distinct != 0 && codes[distinct - 1] == codes[t])
+            {
+                counts[distinct - 1]++;
+            }
+            else
+            {
+                codes[distinct] = codes[t];
+                counts[distinct++] = 1;
+            }
+        }
+    }
+    return distinct;
+}
+
+// Merge the sorted transition codes and counts of a chunk into a matrix, and
+// recompute its rows and probabilities.
+static bool merge_transitions(inform_history_tpm *tpm, uint64_t const *codes,
+    uint64_t const *counts, size_t distinct)
+{
+    uint64_t const b = tpm->b;
+    size_t const capacity = tpm->nnz + distinct;
+    uint64_t *histories = malloc(capacity * sizeof(uint64_t));
+    size_t *offsets = malloc((capacity + 1) * sizeof(size_t));
+    int *futures = malloc(capacity * sizeof(int));
+    uint64_t *merged = malloc(capacity * sizeof(uint64_t));
+    double *values = malloc(capacity * sizeof(double));
+    if (!histories || !offsets || !futures || !merged || !values)
+    {
+        free(values);
+        free(merged);
+        free(futures);
+        free(offsets);
+        free(histories);
+        return false;
+    }
+
+    size_t i = 0, j = 0, row = 0, nnz = 0, old_row = 0;
+    while (i < tpm->nnz || j < distinct)
+    {
+        while (old_row < tpm->rows && tpm->offsets[old_row + 1] <= i)
+            ++old_row;
+        uint64_t const old = (i < tpm->nnz) ?
+            tpm->histories[old_row] * b + tpm->futures[i] : UINT64_MAX;
+        uint64_t code, count;
+        if (j == distinct || (i < tpm->nnz && old <= codes[j]))
+        {
+            code = old;
+            count = tpm->counts[i];
+            if (j < distinct && old == codes[j])
+                count += counts[j++];
+            ++i;
+        }
+        else
+        {
+            code = codes[j];
+            count = counts[j++];
+        }
+
+        uint64_t const history = code / b;
+        if (row == 0 || histories[row - 1] != history)
+        {
+            histories[row] = history;
+            offsets[row++] = nnz;
+        }
+        futures[nnz] = (int)(code % b);
+        merged[nnz++] = count;
+    }
+    offsets[row] = nnz;
+
+    for (size_t r = 0; r < row; ++r)
+    {
+        uint64_t total = 0;
+        for (size_t e = offsets[r]; e < offsets[r + 1]; ++e)
+            total += merged[e];
+        for (size_t e = offsets[r]; e < offsets[r + 1]; ++e)
+            values[e] = (double) merged[e] / total;
+    }
+
+    free(tpm->values);
+    free(tpm->counts);
+    free(tpm->futures);
+    free(tpm->offsets);
+    free(tpm->histories);
+    tpm->rows = row;
+    tpm->nnz = nnz;
+    tpm->histories = histories;
+    tpm->offsets = offsets;
+    tpm->futures = futures;
+    tpm->counts = merged;
+    tpm->values = values;
+    return true;
+}
+
+inform_history_tpm *inform_tpm_k(int const *series, size_t n, size_t m, int b,
+    size_t k, inform_history_tpm *tpm, inform_error *err)
+{
+    if (check_arguments(series, n, m, b, err))
+        return NULL;
+    else if (k == 0)
+        INFORM_ERROR_RETURN(err, INFORM_EKZERO, NULL);
+    else if (m <= k)
+        INFORM_ERROR_RETURN(err, INFORM_EKLONG, NULL);
+    else if ((k + 1) * log2(b) > 63)
+        INFORM_ERROR_RETURN(err, INFORM_EENCODE, NULL);
+    else if (tpm != NULL && (tpm->b != b || tpm->k != k))
+        INFORM_ERROR_RETURN(err, INFORM_EARG, NULL);
+
+    bool const allocate = (tpm == NULL);
+    if (allocate)
+    {
+        tpm = calloc(1, sizeof(inform_history_tpm));
+        if (tpm == NULL)
+            INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+        tpm->b = b;
+        tpm->k = k;
+    }
+
+    size_t const N = n * (m - k);
+    uint64_t *codes = malloc(2 * N * sizeof(uint64_t));
+    if (codes == NULL)
+    {
+        if (allocate) inform_history_tpm_free(tpm);
+        INFORM_ERROR_RETURN(err, INFORM_ENOMEM, NULL);
+    }
+    uint64_t *counts = codes + N;
+
+    // roll the encoding of each history along the series
+    uint64_t q = 1;
+    for (size_t i = 0; i < k; ++i) q *= b;
+    size_t t = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        int const *x = series + m * i;
+        uint64_t history = 0;
+        for (size_t j = 0; j < k; ++j)
+            history = history * b + x[j];
+        for (size_t j = k; j < m; ++j)
+        {
+            uint64_t const state = history * b + x[j];
+            codes[t++] = state;
+            history = state - x[j - k] * q;
+        }
+    }
+
+    size_t const distinct = count_codes(codes, N, q * b, counts, err);
+    if (inform_succeeded(err) && !merge_transitions(tpm, codes, counts, distinct))
+    {
+        INFORM_ERROR(err, INFORM_ENOMEM);
+    }
+    free(codes);
+
+    if (inform_failed(err))
+    {
+        if (allocate) inform_history_tpm_free(tpm);
+        return NULL;
+    }
+    return tpm;
+}
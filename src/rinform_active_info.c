@@ -21,3 +21,21 @@ void r_local_active_info_(int *series, int *n, int *m, int *b, int *k, double *r
 }
 
 
+
+void r_active_info_binned_(double *series, int *n, int *m, int *method, int *b,
+			   double *step, double *bounds, int *nbounds, int *k,
+			   double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_binning spec = { *method, *b, *step, bounds, *nbounds, 0.0, 0.0 };
+
+  *rval = inform_active_info_binned(series, *n, *m, &spec, *k, &ierr);
+  *err  = ierr;
+}
+
+void r_active_info_ensemble_(int *series, int *n, int *m, int *b, int *k, double *rval,
+			     int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_active_info_ensemble(series, *n, *m, *b, *k, rval, &ierr);
+  *err = ierr;
+}
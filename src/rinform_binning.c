@@ -36,3 +36,43 @@ void r_bin_series_bounds_(double *series, int *n, int *b, double *bounds, int *m
   *b   = inform_bin_bounds(series, *n, bounds, *m, binned, &ierr);
   *err = ierr;
 }
+
+void r_bin_columns_bin_(double *series, int *n, int *c, int *b, int *binned,
+			double *bin_size, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_bin_columns(series, *n, *c, *b, binned, bin_size, &ierr);
+  *err = ierr;
+}
+
+void r_bin_columns_step_(double *series, int *n, int *c, double *step, int *binned,
+			 int *b, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_bin_step_columns(series, *n, *c, *step, binned, b, &ierr);
+  *err = ierr;
+}
+
+void r_bin_columns_bounds_(double *series, int *n, int *c, double *bounds, int *m,
+			   int *binned, int *b, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_bin_bounds_columns(series, *n, *c, bounds, *m, binned, b, &ierr);
+  *err = ierr;
+}
+
+void r_bin_series_quantile_(double *series, int *n, int *b, int *binned,
+			    double *bounds, int *nbins, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *nbins = inform_bin_quantile(series, *n, *b, binned, bounds, &ierr);
+  *err   = ierr;
+}
+
+void r_bin_columns_quantile_(double *series, int *n, int *c, int *b, int *binned,
+			     double *bounds, int *nbins, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_bin_quantile_columns(series, *n, *c, *b, binned, bounds, nbins, &ierr);
+  *err = ierr;
+}
@@ -5,6 +5,7 @@
 /*******************************************************************************/
 #include <R.h>
 #include "inform/utilities/black_boxing.h"
+#include "inform/utilities/coalesce.h"
 
 void r_black_box_(int *series, int *l, int *n, int *m, int *b, int *r, int *rNull,
 		  int *s, int *sNull, int *box, int *err) {
@@ -22,6 +23,27 @@ void r_black_box_(int *series, int *l, int *n, int *m, int *b, int *r, int *rNul
   *err = ierr;
 }
 
+void r_black_box_coalesced_(int *series, int *l, int *n, int *m, int *b, int *r,
+			    int *rNull, int *s, int *sNull, int *box, int *nbox,
+			    int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  size_t *R = (size_t *) R_alloc(*l, sizeof(size_t));
+  size_t *S = (size_t *) R_alloc(*l, sizeof(size_t));
+  uint64_t *codes = (uint64_t *) R_alloc(*nbox, sizeof(uint64_t));
+
+  for (size_t i = 0; i < *l; ++i) {
+    if (*rNull == 0) { R[i] = r[i]; }
+    if (*sNull == 0) { S[i] = s[i]; }
+  }
+
+  inform_black_box_codes(series, *l, *n, *m, b, *rNull ? NULL : R,
+			 *sNull ? NULL : S, codes, &ierr);
+  if (ierr == INFORM_SUCCESS) {
+    inform_coalesce_codes(codes, *nbox, box, &ierr);
+  }
+  *err = ierr;
+}
+
 void r_black_box_parts_(int *series, int *l, int *n, int *b, int *parts,
 			int *nparts, int *box, int *err) {    
   inform_error ierr = INFORM_SUCCESS;
@@ -0,0 +1,38 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include <R.h>
+#include "inform/causal_emergence.h"
+
+void r_causal_emergence_(double *tpm, int *n, int *mode, int *iterations,
+			 int *restarts, double *seed, int *groups, double *rval,
+			 int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_emergence_search search;
+  size_t *st_groups = (size_t*) R_alloc(*n, sizeof(size_t));
+
+  search.mode       = (inform_emergence_mode) *mode;
+  search.iterations = *iterations;
+  search.restarts   = *restarts;
+  search.seed       = (uint64_t) *seed;
+
+  *rval = inform_causal_emergence(tpm, *n, &search, st_groups, &ierr);
+  for (int i = 0; i < *n; ++i) {
+    groups[i] = st_groups[i];
+  }
+  *err  = ierr;
+}
+
+void r_macro_tpm_(double *tpm, int *n, int *groups, int *k, double *macro,
+		  int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  size_t *st_groups = (size_t*) R_alloc(*n, sizeof(size_t));
+
+  for (int i = 0; i < *n; ++i) {
+    st_groups[i] = groups[i];
+  }
+  inform_macro_tpm(tpm, *n, st_groups, *k, macro, &ierr);
+  *err  = ierr;
+}
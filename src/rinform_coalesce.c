@@ -11,3 +11,17 @@ void r_coalesce_(int *series, int *n, int *coal, int *b, int *err) {
   *b   = inform_coalesce(series, *n, coal, &ierr);
   *err = ierr;
 }
+
+void r_coalesce_columns_(int *series, int *n, int *c, int *coal, int *b, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_coalesce_columns(series, *n, *c, coal, b, &ierr);
+  *err = ierr;
+}
+
+void r_coalesce_joint_(int *series, int *n, int *c, int *coal, int *b, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *b   = inform_coalesce_joint(series, *n, *c, coal, &ierr);
+  *err = ierr;
+}
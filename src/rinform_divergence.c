@@ -0,0 +1,21 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include "inform/divergence.h"
+
+void r_divergence_matrix_(int *ps, int *np, int *qs, int *nq, int *n, int *b, int *measure,
+			  double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  // without series of its own, each series of <ps> is compared with every other
+  if (*nq == 0) {
+    inform_divergence_matrix(ps, *np, ps, *np, *n, *b, (inform_divergence) *measure,
+			     rval, &ierr);
+  } else {
+    inform_divergence_matrix(ps, *np, qs, *nq, *n, *b, (inform_divergence) *measure,
+			     rval, &ierr);
+  }
+  *err = ierr;
+}
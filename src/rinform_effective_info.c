@@ -3,6 +3,7 @@
 // Use of this source code is governed by a MIT license that can be found in the
 // LICENSE file.
 /*******************************************************************************/
+#include <R.h>
 #include "inform/effective_info.h"
 
 void r_effective_info_(double *tpm, double *inter, int *n, double *rval, int *err) {
@@ -19,4 +20,72 @@ void r_effective_info_uniform_(double *tpm, int *n, double *rval, int *err) {
   *err  = ierr;
 }
 
+static inform_sparse_tpm r_sparse_tpm(int *p, int *i, double *x, int n, int nnz) {
+  inform_sparse_tpm tpm;
 
+  tpm.size    = n;
+  tpm.nnz     = nnz;
+  tpm.offsets = (size_t*) R_alloc(n + 1, sizeof(size_t));
+  tpm.columns = (size_t*) R_alloc(nnz + 1, sizeof(size_t));
+  tpm.values  = x;
+  for (size_t k = 0; k <= (size_t) n; ++k) {
+    tpm.offsets[k] = p[k];
+  }
+  for (size_t k = 0; k < (size_t) nnz; ++k) {
+    tpm.columns[k] = i[k];
+  }
+  return tpm;
+}
+
+void r_effective_info_sparse_(int *p, int *i, double *x, int *n, int *nnz,
+			      double *inter, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_sparse_tpm tpm = r_sparse_tpm(p, i, x, *n, *nnz);
+
+  *rval = inform_effective_info_sparse(&tpm, inter, &ierr);
+  *err  = ierr;
+}
+
+void r_effective_info_sparse_uniform_(int *p, int *i, double *x, int *n, int *nnz,
+				      double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_sparse_tpm tpm = r_sparse_tpm(p, i, x, *n, *nnz);
+
+  *rval = inform_effective_info_sparse(&tpm, NULL, &ierr);
+  *err  = ierr;
+}
+
+static size_t *r_network_inputs(int *nodes, int *k, int *inputs, size_t **st_k) {
+  size_t nin = 0;
+
+  *st_k = (size_t*) R_alloc(*nodes, sizeof(size_t));
+  for (size_t i = 0; i < (size_t) *nodes; ++i) {
+    (*st_k)[i] = k[i];
+    nin       += k[i];
+  }
+  size_t *st_inputs = (size_t*) R_alloc(nin + 1, sizeof(size_t));
+  for (size_t i = 0; i < nin; ++i) {
+    st_inputs[i] = inputs[i];
+  }
+  return st_inputs;
+}
+
+void r_effective_info_boolean_(int *nodes, int *k, int *inputs, double *tables,
+			       double *inter, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  size_t *st_k;
+  size_t *st_inputs = r_network_inputs(nodes, k, inputs, &st_k);
+
+  *rval = inform_effective_info_boolean(*nodes, st_k, st_inputs, tables, inter, &ierr);
+  *err  = ierr;
+}
+
+void r_effective_info_boolean_uniform_(int *nodes, int *k, int *inputs, double *tables,
+				       double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  size_t *st_k;
+  size_t *st_inputs = r_network_inputs(nodes, k, inputs, &st_k);
+
+  *rval = inform_effective_info_boolean(*nodes, st_k, st_inputs, tables, NULL, &ierr);
+  *err  = ierr;
+}
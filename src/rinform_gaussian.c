@@ -0,0 +1,46 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include "inform/gaussian.h"
+
+void r_gaussian_mutual_info_(double *series, int *l, int *n, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *rval = inform_gaussian_mutual_info(series, *l, *n, &ierr);
+  *err = ierr;
+}
+
+void r_gaussian_conditional_entropy_(double *xs, double *ys, int *n, double *rval,
+				     int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *rval = inform_gaussian_conditional_entropy(xs, ys, *n, &ierr);
+  *err = ierr;
+}
+
+void r_gaussian_transfer_entropy_(double *ys, double *xs, int *n, int *m, int *k,
+				  double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *rval = inform_gaussian_transfer_entropy(ys, xs, NULL, 0, *n, *m, *k, &ierr);
+  *err = ierr;
+}
+
+void r_complete_gaussian_transfer_entropy_(double *ys, double *xs, double *ws, int *l,
+					   int *n, int *m, int *k, double *rval,
+					   int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  *rval = inform_gaussian_transfer_entropy(ys, xs, ws, *l, *n, *m, *k, &ierr);
+  *err = ierr;
+}
+
+void r_gaussian_transfer_entropy_matrix_(double *series, int *l, int *n, int *m, int *k,
+					 double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_gaussian_transfer_entropy_matrix(series, *l, *n, *m, *k, rval, &ierr);
+  *err = ierr;
+}
@@ -3,6 +3,7 @@
 // Use of this source code is governed by a MIT license that can be found in the
 // LICENSE file.
 /*******************************************************************************/
+#include <R.h>
 #include "inform/information_flow.h"
 
 void r_info_flow_(int *src, int *dst, int *lsrc, int *ldst, int *n, int *m, int *b,
@@ -21,3 +22,27 @@ void r_info_flow_back_(int *src, int *dst, int *back, int *lsrc, int *ldst, int
   *err  = ierr;
 }
 
+
+void r_info_flow_matrix_(int *series, int *l, int *srcs, int *src_sizes, int *nsrc,
+			 int *dsts, int *dst_sizes, int *ndst, int *back, int *lback,
+			 int *n, int *m, int *b, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  size_t nsrcs = 0, ndsts = 0;
+  for (int i = 0; i < *nsrc; ++i) nsrcs += src_sizes[i];
+  for (int i = 0; i < *ndst; ++i) ndsts += dst_sizes[i];
+
+  size_t *st_srcs      = (size_t*) R_alloc(nsrcs, sizeof(size_t));
+  size_t *st_src_sizes = (size_t*) R_alloc(*nsrc, sizeof(size_t));
+  size_t *st_dsts      = (size_t*) R_alloc(ndsts, sizeof(size_t));
+  size_t *st_dst_sizes = (size_t*) R_alloc(*ndst, sizeof(size_t));
+  for (size_t i = 0; i < nsrcs; ++i) st_srcs[i] = srcs[i];
+  for (int i = 0; i < *nsrc; ++i)    st_src_sizes[i] = src_sizes[i];
+  for (size_t i = 0; i < ndsts; ++i) st_dsts[i] = dsts[i];
+  for (int i = 0; i < *ndst; ++i)    st_dst_sizes[i] = dst_sizes[i];
+
+  inform_information_flow_matrix(series, *l, st_srcs, st_src_sizes, *nsrc,
+				 st_dsts, st_dst_sizes, *ndst,
+				 (*lback == 0) ? NULL : back, *lback, *n, *m, *b,
+				 rval, &ierr);
+  *err  = ierr;
+}
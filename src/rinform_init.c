@@ -8,67 +8,111 @@
 #include "rinform_init.h"
 
 static const R_CMethodDef CEntries[] = {
-    {"r_accumulate_",                      (DL_FUNC) &r_accumulate_,                       6},
-    {"r_active_info_",                     (DL_FUNC) &r_active_info_,                      7},
-    {"r_approximate_",                     (DL_FUNC) &r_approximate_,                      5},
-    {"r_bin_series_bin_",                  (DL_FUNC) &r_bin_series_bin_,                   6},
-    {"r_bin_series_bounds_",               (DL_FUNC) &r_bin_series_bounds_,                7},
-    {"r_bin_series_step_",                 (DL_FUNC) &r_bin_series_step_,                  6},
-    {"r_black_box_",                       (DL_FUNC) &r_black_box_,                       11},
-    {"r_black_box_parts_",                 (DL_FUNC) &r_black_box_parts_,                  8},
-    {"r_block_entropy_",                   (DL_FUNC) &r_block_entropy_,                    7},
-    {"r_coalesce_",                        (DL_FUNC) &r_coalesce_,                         5},
-    {"r_complete_transfer_entropy_",       (DL_FUNC) &r_complete_transfer_entropy_,       10},
-    {"r_conditional_entropy_",             (DL_FUNC) &r_conditional_entropy_,              7},
-    {"r_copy_",                            (DL_FUNC) &r_copy_,                             6},
-    {"r_counts_",                          (DL_FUNC) &r_counts_,                           4},
-    {"r_cross_entropy_",                   (DL_FUNC) &r_cross_entropy_,                    6},
-    {"r_decode_",                          (DL_FUNC) &r_decode_,                           5},
-    {"r_dist_",                            (DL_FUNC) &r_dist_,                             4},
-    {"r_dump_",                            (DL_FUNC) &r_dump_,                             4},
-    {"r_effective_info_",                  (DL_FUNC) &r_effective_info_,                   5},
-    {"r_effective_info_uniform_",          (DL_FUNC) &r_effective_info_uniform_,           4},
-    {"r_encode_",                          (DL_FUNC) &r_encode_,                           5},
-    {"r_entropy_rate_",                    (DL_FUNC) &r_entropy_rate_,                     7},
-    {"r_excess_entropy_",                  (DL_FUNC) &r_excess_entropy_,                   7},
-    {"r_get_item_",                        (DL_FUNC) &r_get_item_,                         6},
-    {"r_infer_",                           (DL_FUNC) &r_infer_,                            4},
-    {"r_info_flow_",                       (DL_FUNC) &r_info_flow_,                        9},
-    {"r_info_flow_back_",                  (DL_FUNC) &r_info_flow_back_,                  11},
-    {"r_integration_evidence_",            (DL_FUNC) &r_integration_evidence_,             6},
-    {"r_integration_evidence_parts_",      (DL_FUNC) &r_integration_evidence_parts_,       8},
-    {"r_length_",                          (DL_FUNC) &r_length_,                           5},
-    {"r_local_active_info_",               (DL_FUNC) &r_local_active_info_,                7},
-    {"r_local_block_entropy_",             (DL_FUNC) &r_local_block_entropy_,              7},
-    {"r_local_complete_transfer_entropy_", (DL_FUNC) &r_local_complete_transfer_entropy_, 10},
-    {"r_local_conditional_entropy_",       (DL_FUNC) &r_local_conditional_entropy_,        7},
-    {"r_local_entropy_rate_",              (DL_FUNC) &r_local_entropy_rate_,               7},
-    {"r_local_excess_entropy_",            (DL_FUNC) &r_local_excess_entropy_,             7},
-    {"r_local_mutual_info_",               (DL_FUNC) &r_local_mutual_info_,                6},
-    {"r_local_predictive_info_",           (DL_FUNC) &r_local_predictive_info_,            8},
-    {"r_local_relative_entropy_",          (DL_FUNC) &r_local_relative_entropy_,           6},
-    {"r_local_separable_info_",            (DL_FUNC) &r_local_separable_info_,             9},
-    {"r_local_transfer_entropy_",          (DL_FUNC) &r_local_transfer_entropy_,           8},
-    {"r_mutual_info_",                     (DL_FUNC) &r_mutual_info_,                      6},
-    {"r_partitioning_",                    (DL_FUNC) &r_partitioning_,                     2},
-    {"r_predictive_info_",                 (DL_FUNC) &r_predictive_info_,                  8},
-    {"r_probability_",                     (DL_FUNC) &r_probability_,                      5},
-    {"r_relative_entropy_",                (DL_FUNC) &r_relative_entropy_,                 6},
-    {"r_resize_",                          (DL_FUNC) &r_resize_,                           6},
-    {"r_separable_info_",                  (DL_FUNC) &r_separable_info_,                   9},
-    {"r_series_range_",                    (DL_FUNC) &r_series_range_,                     6},
-    {"r_series_to_tpm_",                   (DL_FUNC) &r_series_to_tpm_,                    6},
-    {"r_set_item_",                        (DL_FUNC) &r_set_item_,                         6},
-    {"r_shannon_cond_mutual_info_",        (DL_FUNC) &r_shannon_cond_mutual_info_,        11},
-    {"r_shannon_conditional_entropy_",     (DL_FUNC) &r_shannon_conditional_entropy_,      7},
-    {"r_shannon_cross_entropy_",           (DL_FUNC) &r_shannon_cross_entropy_,            7},
-    {"r_shannon_entropy_",                 (DL_FUNC) &r_shannon_entropy_,                  5},
-    {"r_shannon_mutual_info_",             (DL_FUNC) &r_shannon_mutual_info_,              9},
-    {"r_shannon_relative_entropy_",        (DL_FUNC) &r_shannon_relative_entropy_,         7},
-    {"r_tick_",                            (DL_FUNC) &r_tick_,                             5},
-    {"r_transfer_entropy_",                (DL_FUNC) &r_transfer_entropy_,                 8},
-    {"r_uniform_",                         (DL_FUNC) &r_uniform_,                          5},
-    {"r_valid_",                           (DL_FUNC) &r_valid_,                            4},
+    {"r_accumulate_",                         (DL_FUNC) &r_accumulate_,                          6},
+    {"r_active_info_",                        (DL_FUNC) &r_active_info_,                         7},
+    {"r_active_info_binned_",                 (DL_FUNC) &r_active_info_binned_,                 11},
+    {"r_active_info_ensemble_",               (DL_FUNC) &r_active_info_ensemble_,                7},
+    {"r_active_info_sweep_",                  (DL_FUNC) &r_active_info_sweep_,                   8},
+    {"r_approximate_",                        (DL_FUNC) &r_approximate_,                         5},
+    {"r_bin_columns_bin_",                    (DL_FUNC) &r_bin_columns_bin_,                     7},
+    {"r_bin_columns_bounds_",                 (DL_FUNC) &r_bin_columns_bounds_,                  8},
+    {"r_bin_columns_quantile_",               (DL_FUNC) &r_bin_columns_quantile_,                8},
+    {"r_bin_columns_step_",                   (DL_FUNC) &r_bin_columns_step_,                    7},
+    {"r_bin_series_bin_",                     (DL_FUNC) &r_bin_series_bin_,                      6},
+    {"r_bin_series_bounds_",                  (DL_FUNC) &r_bin_series_bounds_,                   7},
+    {"r_bin_series_quantile_",                (DL_FUNC) &r_bin_series_quantile_,                 7},
+    {"r_bin_series_step_",                    (DL_FUNC) &r_bin_series_step_,                     6},
+    {"r_black_box_",                          (DL_FUNC) &r_black_box_,                          11},
+    {"r_black_box_coalesced_",                (DL_FUNC) &r_black_box_coalesced_,                12},
+    {"r_black_box_parts_",                    (DL_FUNC) &r_black_box_parts_,                     8},
+    {"r_block_entropy_",                      (DL_FUNC) &r_block_entropy_,                       7},
+    {"r_causal_emergence_",                   (DL_FUNC) &r_causal_emergence_,                    9},
+    {"r_coalesce_",                           (DL_FUNC) &r_coalesce_,                            5},
+    {"r_coalesce_columns_",                   (DL_FUNC) &r_coalesce_columns_,                    6},
+    {"r_coalesce_joint_",                     (DL_FUNC) &r_coalesce_joint_,                      6},
+    {"r_complete_gaussian_transfer_entropy_", (DL_FUNC) &r_complete_gaussian_transfer_entropy_,  9},
+    {"r_complete_transfer_entropy_",          (DL_FUNC) &r_complete_transfer_entropy_,          10},
+    {"r_conditional_entropy_",                (DL_FUNC) &r_conditional_entropy_,                 7},
+    {"r_copy_",                               (DL_FUNC) &r_copy_,                                6},
+    {"r_counts_",                             (DL_FUNC) &r_counts_,                              4},
+    {"r_cross_entropy_",                      (DL_FUNC) &r_cross_entropy_,                       6},
+    {"r_decode_",                             (DL_FUNC) &r_decode_,                              5},
+    {"r_dist_",                               (DL_FUNC) &r_dist_,                                4},
+    {"r_divergence_matrix_",                  (DL_FUNC) &r_divergence_matrix_,                   9},
+    {"r_dump_",                               (DL_FUNC) &r_dump_,                                4},
+    {"r_effective_info_",                     (DL_FUNC) &r_effective_info_,                      5},
+    {"r_effective_info_boolean_",             (DL_FUNC) &r_effective_info_boolean_,              7},
+    {"r_effective_info_boolean_uniform_",     (DL_FUNC) &r_effective_info_boolean_uniform_,      6},
+    {"r_effective_info_sparse_",              (DL_FUNC) &r_effective_info_sparse_,               8},
+    {"r_effective_info_sparse_uniform_",      (DL_FUNC) &r_effective_info_sparse_uniform_,       7},
+    {"r_effective_info_uniform_",             (DL_FUNC) &r_effective_info_uniform_,              4},
+    {"r_encode_",                             (DL_FUNC) &r_encode_,                              5},
+    {"r_entropy_rate_",                       (DL_FUNC) &r_entropy_rate_,                        7},
+    {"r_excess_entropy_",                     (DL_FUNC) &r_excess_entropy_,                      7},
+    {"r_gaussian_conditional_entropy_",       (DL_FUNC) &r_gaussian_conditional_entropy_,        5},
+    {"r_gaussian_mutual_info_",               (DL_FUNC) &r_gaussian_mutual_info_,                5},
+    {"r_gaussian_transfer_entropy_",          (DL_FUNC) &r_gaussian_transfer_entropy_,           7},
+    {"r_gaussian_transfer_entropy_matrix_",   (DL_FUNC) &r_gaussian_transfer_entropy_matrix_,    7},
+    {"r_get_item_",                           (DL_FUNC) &r_get_item_,                            6},
+    {"r_infer_",                              (DL_FUNC) &r_infer_,                               4},
+    {"r_info_flow_",                          (DL_FUNC) &r_info_flow_,                           9},
+    {"r_info_flow_back_",                     (DL_FUNC) &r_info_flow_back_,                     11},
+    {"r_info_flow_matrix_",                   (DL_FUNC) &r_info_flow_matrix_,                   15},
+    {"r_integration_evidence_",               (DL_FUNC) &r_integration_evidence_,                6},
+    {"r_integration_evidence_parts_",         (DL_FUNC) &r_integration_evidence_parts_,          8},
+    {"r_integration_evidence_range_",         (DL_FUNC) &r_integration_evidence_range_,          8},
+    {"r_integration_evidence_search_",        (DL_FUNC) &r_integration_evidence_search_,        10},
+    {"r_lagged_mutual_info_",                 (DL_FUNC) &r_lagged_mutual_info_,                  9},
+    {"r_lattice_active_info_",                (DL_FUNC) &r_lattice_active_info_,                 8},
+    {"r_lattice_separable_info_",             (DL_FUNC) &r_lattice_separable_info_,             11},
+    {"r_lattice_transfer_entropy_",           (DL_FUNC) &r_lattice_transfer_entropy_,           10},
+    {"r_length_",                             (DL_FUNC) &r_length_,                              5},
+    {"r_local_active_info_",                  (DL_FUNC) &r_local_active_info_,                   7},
+    {"r_local_block_entropy_",                (DL_FUNC) &r_local_block_entropy_,                 7},
+    {"r_local_complete_transfer_entropy_",    (DL_FUNC) &r_local_complete_transfer_entropy_,    10},
+    {"r_local_conditional_entropy_",          (DL_FUNC) &r_local_conditional_entropy_,           7},
+    {"r_local_entropy_rate_",                 (DL_FUNC) &r_local_entropy_rate_,                  7},
+    {"r_local_excess_entropy_",               (DL_FUNC) &r_local_excess_entropy_,                7},
+    {"r_local_mutual_info_",                  (DL_FUNC) &r_local_mutual_info_,                   6},
+    {"r_local_predictive_info_",              (DL_FUNC) &r_local_predictive_info_,               8},
+    {"r_local_relative_entropy_",             (DL_FUNC) &r_local_relative_entropy_,              6},
+    {"r_local_separable_info_",               (DL_FUNC) &r_local_separable_info_,                9},
+    {"r_local_transfer_entropy_",             (DL_FUNC) &r_local_transfer_entropy_,              8},
+    {"r_macro_tpm_",                          (DL_FUNC) &r_macro_tpm_,                           6},
+    {"r_mutual_info_",                        (DL_FUNC) &r_mutual_info_,                         6},
+    {"r_mutual_info_ensemble_",               (DL_FUNC) &r_mutual_info_ensemble_,                7},
+    {"r_mutual_info_matrix_",                 (DL_FUNC) &r_mutual_info_matrix_,                  9},
+    {"r_partitioning_",                       (DL_FUNC) &r_partitioning_,                        4},
+    {"r_pid_",                                (DL_FUNC) &r_pid_,                                13},
+    {"r_pid_lattice_size_",                   (DL_FUNC) &r_pid_lattice_size_,                    5},
+    {"r_predictive_info_",                    (DL_FUNC) &r_predictive_info_,                     8},
+    {"r_probability_",                        (DL_FUNC) &r_probability_,                         5},
+    {"r_qsketch_bounds_",                     (DL_FUNC) &r_qsketch_bounds_,                      7},
+    {"r_qsketch_max_size_",                   (DL_FUNC) &r_qsketch_max_size_,                    2},
+    {"r_qsketch_merge_",                      (DL_FUNC) &r_qsketch_merge_,                       9},
+    {"r_qsketch_update_",                     (DL_FUNC) &r_qsketch_update_,                      8},
+    {"r_relative_entropy_",                   (DL_FUNC) &r_relative_entropy_,                    6},
+    {"r_resize_",                             (DL_FUNC) &r_resize_,                              6},
+    {"r_separable_info_",                     (DL_FUNC) &r_separable_info_,                      9},
+    {"r_series_range_",                       (DL_FUNC) &r_series_range_,                        6},
+    {"r_series_to_sparse_tpm_",               (DL_FUNC) &r_series_to_sparse_tpm_,                9},
+    {"r_series_to_tpm_",                      (DL_FUNC) &r_series_to_tpm_,                       6},
+    {"r_series_to_tpm_k_",                    (DL_FUNC) &r_series_to_tpm_k_,                    10},
+    {"r_set_item_",                           (DL_FUNC) &r_set_item_,                            6},
+    {"r_shannon_cond_mutual_info_",           (DL_FUNC) &r_shannon_cond_mutual_info_,           11},
+    {"r_shannon_conditional_entropy_",        (DL_FUNC) &r_shannon_conditional_entropy_,         7},
+    {"r_shannon_cross_entropy_",              (DL_FUNC) &r_shannon_cross_entropy_,               7},
+    {"r_shannon_entropy_",                    (DL_FUNC) &r_shannon_entropy_,                     5},
+    {"r_shannon_mutual_info_",                (DL_FUNC) &r_shannon_mutual_info_,                 9},
+    {"r_shannon_relative_entropy_",           (DL_FUNC) &r_shannon_relative_entropy_,            7},
+    {"r_subset_entropy_",                     (DL_FUNC) &r_subset_entropy_,                      6},
+    {"r_tick_",                               (DL_FUNC) &r_tick_,                                5},
+    {"r_transfer_entropy_",                   (DL_FUNC) &r_transfer_entropy_,                    8},
+    {"r_transfer_entropy_binned_",            (DL_FUNC) &r_transfer_entropy_binned_,            14},
+    {"r_transfer_entropy_ensemble_",          (DL_FUNC) &r_transfer_entropy_ensemble_,          10},
+    {"r_transfer_entropy_sweep_",             (DL_FUNC) &r_transfer_entropy_sweep_,              9},
+    {"r_uniform_",                            (DL_FUNC) &r_uniform_,                             5},
+    {"r_valid_",                              (DL_FUNC) &r_valid_,                               4},
     {NULL, NULL, 0}
 };
 
@@ -9,6 +9,11 @@ extern void r_active_info_(int *series, int *n, int *m, int *b, int *k,
 			   double *rval, int *err);
 extern void r_local_active_info_(int *series, int *n, int *m, int *b, int *k,
 				 double *rval, int *err);
+extern void r_active_info_binned_(double *series, int *n, int *m, int *method, int *b,
+				  double *step, double *bounds, int *nbounds, int *k,
+				  double *rval, int *err);
+extern void r_active_info_ensemble_(int *series, int *n, int *m, int *b, int *k,
+				    double *rval, int *err);
 
 /* rinform_binning.c */
 extern void r_series_range_(double *series, int *n, double *srange, double *smin,
@@ -19,10 +24,23 @@ extern void r_bin_series_step_(double *series, int *n, int *b, int *binned,
 			    double *step, int *err);
 extern void r_bin_series_bounds_(double *series, int *n, int *b, double *bounds, int *m,
 		            int *binned, int *err);
+extern void r_bin_columns_bin_(double *series, int *n, int *c, int *b, int *binned,
+			       double *bin_size, int *err);
+extern void r_bin_columns_step_(double *series, int *n, int *c, double *step,
+				int *binned, int *b, int *err);
+extern void r_bin_columns_bounds_(double *series, int *n, int *c, double *bounds, int *m,
+				  int *binned, int *b, int *err);
+extern void r_bin_series_quantile_(double *series, int *n, int *b, int *binned,
+				   double *bounds, int *nbins, int *err);
+extern void r_bin_columns_quantile_(double *series, int *n, int *c, int *b, int *binned,
+				    double *bounds, int *nbins, int *err);
 
 /* rinform_black_box.c */
 extern void r_black_box_(int *series, int *l, int *n, int *m, int *b, int *r, int *rNull,
 			 int *s, int *sNull, int *box, int *err);
+extern void r_black_box_coalesced_(int *series, int *l, int *n, int *m, int *b, int *r,
+				   int *rNull, int *s, int *sNull, int *box, int *nbox,
+				   int *err);
 extern void r_black_box_parts_(int *series, int *l, int *n, int *b, int *parts,
 			       int *nparts, int *box, int *err);
 
@@ -32,8 +50,19 @@ extern void r_block_entropy_(int *series, int *n, int *m, int *b, int *k,
 extern void r_local_block_entropy_(int *series, int *n, int *m, int *b, int *k,
 				   double *rval, int *err);
 
+/* rinform_causal_emergence.c */
+extern void r_causal_emergence_(double *tpm, int *n, int *mode, int *iterations,
+				int *restarts, double *seed, int *groups, double *rval,
+				int *err);
+extern void r_macro_tpm_(double *tpm, int *n, int *groups, int *k, double *macro,
+			 int *err);
+
 /* rinform_coalesce.c */
 extern void r_coalesce_(int *series, int *n, int *coal, int *b, int *err);
+extern void r_coalesce_columns_(int *series, int *n, int *c, int *coal, int *b,
+				int *err);
+extern void r_coalesce_joint_(int *series, int *n, int *c, int *coal, int *b,
+			      int *err);
 
 /* rinform_conditional_entropy.c */
 extern void r_conditional_entropy_(int *xs, int *ys, int *n, int *bx, int *by,
@@ -66,9 +95,21 @@ extern void r_accumulate_(int *histogram, int *size, int *counts, int *n,
 extern void r_probability_(int *histogram, int *size, int *event, double *prob, int *err);
 extern void r_dump_(int *histogram, int *size, double *prob, int *err);
 
+/* rinform_divergence.c */
+extern void r_divergence_matrix_(int *ps, int *np, int *qs, int *nq, int *n, int *b,
+				 int *measure, double *rval, int *err);
+
 /* rinform_effective_info.c */
 extern void r_effective_info_(double *tpm, double *inter, int *n, double *rval, int *err);
 extern void r_effective_info_uniform_(double *tpm, int *n, double *rval, int *err);
+extern void r_effective_info_sparse_(int *p, int *i, double *x, int *n, int *nnz,
+				     double *inter, double *rval, int *err);
+extern void r_effective_info_sparse_uniform_(int *p, int *i, double *x, int *n, int *nnz,
+					     double *rval, int *err);
+extern void r_effective_info_boolean_(int *nodes, int *k, int *inputs, double *tables,
+				      double *inter, double *rval, int *err);
+extern void r_effective_info_boolean_uniform_(int *nodes, int *k, int *inputs, double *tables,
+					      double *rval, int *err);
 
 /* rinform_encoding.c */
 extern void r_encode_(int *state, int *n, int *b, int *encoded, int *err);
@@ -86,25 +127,58 @@ extern void r_excess_entropy_(int *series, int *n, int *m, int *b, int *k,
 extern void r_local_excess_entropy_(int *series, int *n, int *m, int *b, int *k,
 				    double *rval, int *err);
 
+/* rinform_gaussian.c */
+extern void r_gaussian_mutual_info_(double *series, int *l, int *n, double *rval, int *err);
+extern void r_gaussian_conditional_entropy_(double *xs, double *ys, int *n, double *rval,
+					    int *err);
+extern void r_gaussian_transfer_entropy_(double *ys, double *xs, int *n, int *m, int *k,
+					 double *rval, int *err);
+extern void r_complete_gaussian_transfer_entropy_(double *ys, double *xs, double *ws,
+						  int *l, int *n, int *m, int *k,
+						  double *rval, int *err);
+extern void r_gaussian_transfer_entropy_matrix_(double *series, int *l, int *n, int *m,
+						int *k, double *rval, int *err);
+
 /* rinform_info_flow.c */
 extern void r_info_flow_(int *src, int *dst, int *lsrc, int *ldst, int *n, int *m, int *b,
 			 double *rval, int *err);
 extern void r_info_flow_back_(int *src, int *dst, int *back, int *lsrc, int *ldst,
 			      int *lback, int *n, int *m, int *b, double *rval, int *err);
+extern void r_info_flow_matrix_(int *series, int *l, int *srcs, int *src_sizes, int *nsrc,
+				int *dsts, int *dst_sizes, int *ndst, int *back, int *lback,
+				int *n, int *m, int *b, double *rval, int *err);
 
 /* rinform_integration_evidence.c */
 extern void r_integration_evidence_(int *series, int *l, int *n, int *b,
 			            double *evidence, int *err);
 extern void r_integration_evidence_parts_(int *series, int *l, int *n, int *b, int *parts,
 					  int *nparts, double *evidence, int *err);
+extern void r_integration_evidence_range_(int *series, int *l, int *n, int *b,
+					  double *first, double *count, double *evidence,
+					  int *err);
+extern void r_integration_evidence_search_(int *series, int *l, int *n, int *b,
+					   int *mode, double *iterations, double *seconds,
+					   double *seed, double *evidence, int *err);
 
 /* rinform_mutual_info.c */
 extern void r_mutual_info_(int *series, int *l, int *n, int *b, double *rval, int *err);
 extern void r_local_mutual_info_(int *series, int *l, int *n, int *b,
 				 double *rval, int *err);
+extern void r_mutual_info_matrix_(int *series, int *l, int *n, int *b, int *cond,
+				  int *l_cond, int *b_cond, double *rval, int *err);
+extern void r_lagged_mutual_info_(int *xs, int *ys, int *n, int *m, int *bx, int *by,
+				  int *max_lag, double *rval, int *err);
+extern void r_mutual_info_ensemble_(int *series, int *l, int *n, int *m, int *b,
+				    double *rval, int *err);
 
 /* rinform_partitioning.c */
-extern void r_partitioning_(int *n, int *P);
+extern void r_partitioning_(int *n, double *first, int *count, int *P);
+
+/* rinform_pid.c */
+extern void r_pid_(int *stimulus, int *responses, int *l, int *n, int *bs, int *br,
+		   double *imin, double *pi, int *names, int *name_offsets, int *below,
+		   int *below_offsets, int *err);
+extern void r_pid_lattice_size_(int *l, int *size, int *nnames, int *nbelow, int *err);
 
 /* rinform_predictive_info.c */
 extern void r_predictive_info_(int *series, int *n, int *m, int *b, int *kpast,
@@ -125,6 +199,10 @@ extern void r_local_separable_info_(int *srcs, int *dest, int *l, int *n, int *m
 
 /* rinform_series_to_tpm.c */
 extern void r_series_to_tpm_(int *series, int *n, int *m, int *b, double *tpm, int *err);
+extern void r_series_to_sparse_tpm_(int *series, int *n, int *m, int *b, int *p, int *i,
+				    double *x, int *nnz, int *err);
+extern void r_series_to_tpm_k_(int *series, int *nchunks, int *n, int *m, int *b, int *k,
+			       double *histories, double *tpm, int *rows, int *err);
 
 /* rinform_shannon.c */
 extern void r_shannon_entropy_(int *histogram, int *size, double *b, double *sen, int *err);
@@ -143,6 +221,36 @@ extern void r_shannon_relative_entropy_(int *histogram_p, int *size_p, int *hist
 extern void r_shannon_cross_entropy_(int *histogram_p, int *size_p, int *histogram_q,
 				     int *size_q, double *b, double *sce, int *err);
 
+/* rinform_sketch.c */
+extern void r_qsketch_max_size_(int *k, int *size);
+extern void r_qsketch_update_(int *k, double *values, int *levels, int *size,
+			      double *series, int *n, double *counts, int *err);
+extern void r_qsketch_merge_(int *k, double *values, int *levels, int *size,
+			     double *other_values, int *other_levels, int *other_size,
+			     double *counts, int *err);
+extern void r_qsketch_bounds_(int *k, double *values, int *levels, int *size, int *b,
+			      double *bounds, int *err);
+
+/* rinform_spatiotemporal.c */
+extern void r_lattice_active_info_(int *series, int *dims, int *shape, int *m, int *b,
+				   int *k, double *rval, int *err);
+extern void r_lattice_transfer_entropy_(int *series, int *dims, int *shape, int *boundary,
+					int *offset, int *m, int *b, int *k, double *rval,
+					int *err);
+extern void r_lattice_separable_info_(int *series, int *dims, int *shape, int *boundary,
+				      int *offsets, int *noffsets, int *m, int *b, int *k,
+				      double *rval, int *err);
+
+/* rinform_subset_entropy.c */
+extern void r_subset_entropy_(int *series, int *l, int *n, int *b, double *rval,
+			      int *err);
+
+/* rinform_sweep.c */
+extern void r_active_info_sweep_(double *series, int *n, int *m, int *bs, int *nb,
+				 int *k, double *rval, int *err);
+extern void r_transfer_entropy_sweep_(double *ys, double *xs, int *n, int *m, int *bs,
+				      int *nb, int *k, double *rval, int *err);
+
 /* rinform_transfer_entropy.c */
 extern void r_transfer_entropy_(int *ys, int *xs, int *n, int *m, int *b, int *k,
 				double *rval, int *err);
@@ -153,3 +261,9 @@ extern void r_local_transfer_entropy_(int *ys, int *xs, int *n, int *m, int *b,
 extern void r_local_complete_transfer_entropy_(int *ys, int *xs, int *ws, int *l, int *n,
 					       int *m, int *b, int *k, double *rval,
 					       int *err);
+extern void r_transfer_entropy_binned_(double *ys, double *xs, double *ws, int *l, int *n,
+				       int *m, int *method, int *b, double *step,
+				       double *bounds, int *nbounds, int *k, double *rval,
+				       int *err);
+extern void r_transfer_entropy_ensemble_(int *ys, int *xs, int *ws, int *l, int *n,
+					 int *m, int *b, int *k, double *rval, int *err);
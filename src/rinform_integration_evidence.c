@@ -14,6 +14,16 @@ void r_integration_evidence_(int *series, int *l, int *n, int *b,
   *err = ierr;
 }
 
+void r_integration_evidence_range_(int *series, int *l, int *n, int *b,
+				   double *first, double *count, double *evidence,
+				   int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_integration_evidence_range(series, *l, *n, b, (uint64_t) *first,
+				    (uint64_t) *count, evidence, &ierr);
+  *err = ierr;
+}
+
 void r_integration_evidence_parts_(int *series, int *l, int *n, int *b,
 				   int *parts, int *nparts, double *evidence, int *err) {
   inform_error ierr = INFORM_SUCCESS;
@@ -27,3 +37,17 @@ void r_integration_evidence_parts_(int *series, int *l, int *n, int *b,
   *err = ierr;
 }
 
+void r_integration_evidence_search_(int *series, int *l, int *n, int *b,
+				    int *mode, double *iterations, double *seconds,
+				    double *seed, double *evidence, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_integration_search search;
+
+  search.mode       = (inform_integration_mode) *mode;
+  search.iterations = (size_t) *iterations;
+  search.seconds    = *seconds;
+  search.seed       = (uint64_t) *seed;
+
+  inform_integration_evidence_search(series, *l, *n, b, &search, evidence, &ierr);
+  *err = ierr;
+}
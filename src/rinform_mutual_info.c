@@ -19,4 +19,26 @@ void r_local_mutual_info_(int *series, int *l, int *n, int *b, double *rval, int
   *err = ierr;
 }
 
+void r_mutual_info_matrix_(int *series, int *l, int *n, int *b, int *cond, int *l_cond,
+			   int *b_cond, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_mutual_info_matrix(series, *l, *n, b, cond, *l_cond, b_cond, rval, &ierr);
+  *err = ierr;
+}
 
+void r_lagged_mutual_info_(int *xs, int *ys, int *n, int *m, int *bx, int *by, int *max_lag,
+			   double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_lagged_mutual_info(xs, ys, *n, *m, *bx, *by, *max_lag, rval, &ierr);
+  *err = ierr;
+}
+
+void r_mutual_info_ensemble_(int *series, int *l, int *n, int *m, int *b, double *rval,
+			     int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_mutual_info_ensemble(series, *l, *n, *m, b, rval, &ierr);
+  *err = ierr;
+}
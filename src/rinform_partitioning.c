@@ -3,19 +3,20 @@
 // Use of this source code is governed by a MIT license that can be found in the
 // LICENSE file.
 /*******************************************************************************/
-#include <stdlib.h>
+#include <R.h>
 #include <inform/utilities/partitions.h>
 
-void r_partitioning_(int *n, int *P) {
+void r_partitioning_(int *n, double *first, int *count, int *P) {
   size_t idx = 0;
-  size_t *part = inform_first_partitioning(*n);
+  size_t *part = (size_t *) R_alloc(2 * *n, sizeof(size_t));
+  size_t *blocks = part + *n;
 
-  do {
+  inform_unrank_partitioning((uint64_t) *first, *n, part, blocks);
+  for (int j = 0; j < *count; ++j) {
     for (size_t i = 0; i < *n; ++i) {
       P[idx] = part[i];
       ++idx;
     }
-  } while (inform_next_partitioning(part, *n));
-
-  free(part);
+    inform_next_partitioning_blocks(part, blocks, *n);
+  }
 }
@@ -0,0 +1,47 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include <R.h>
+#include "inform/pid.h"
+
+void r_pid_lattice_size_(int *l, int *size, int *nnames, int *nbelow, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_pid_lattice *lattice = inform_pid_lattice_alloc(*l, &ierr);
+  if (lattice != NULL) {
+    *size   = lattice->size;
+    *nnames = lattice->name_offsets[lattice->size];
+    *nbelow = lattice->below_offsets[lattice->size];
+    inform_pid_lattice_free(lattice);
+  }
+  *err = ierr;
+}
+
+void r_pid_(int *stimulus, int *responses, int *l, int *n, int *bs, int *br,
+	    double *imin, double *pi, int *names, int *name_offsets, int *below,
+	    int *below_offsets, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_pid_lattice *lattice = inform_pid(stimulus, responses, *l, *n, *bs, br,
+					   &ierr);
+  if (lattice != NULL) {
+    for (size_t i = 0; i < lattice->size; ++i) {
+      imin[i] = lattice->imin[i];
+      pi[i]   = lattice->pi[i];
+    }
+    for (size_t i = 0; i <= lattice->size; ++i) {
+      name_offsets[i]  = lattice->name_offsets[i];
+      below_offsets[i] = lattice->below_offsets[i];
+    }
+    for (size_t i = 0; i < lattice->name_offsets[lattice->size]; ++i) {
+      names[i] = lattice->names[i];
+    }
+    for (size_t i = 0; i < lattice->below_offsets[lattice->size]; ++i) {
+      below[i] = lattice->below[i];
+    }
+    inform_pid_lattice_free(lattice);
+  }
+  *err = ierr;
+}
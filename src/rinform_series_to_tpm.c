@@ -3,6 +3,7 @@
 // Use of this source code is governed by a MIT license that can be found in the
 // LICENSE file.
 /*******************************************************************************/
+#include <R.h>
 #include <inform/utilities/tpm.h>
 
 void r_series_to_tpm_(int *series, int *n, int *m, int *b, double *tpm, int *err) {
@@ -11,3 +12,48 @@ void r_series_to_tpm_(int *series, int *n, int *m, int *b, double *tpm, int *err
   inform_tpm(series, *n, *m, *b, tpm, &ierr);
   *err = ierr;
 }
+
+void r_series_to_sparse_tpm_(int *series, int *n, int *m, int *b, int *p, int *i,
+			     double *x, int *nnz, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_sparse_tpm *tpm = inform_tpm_sparse(series, *n, *m, *b, &ierr);
+  if (tpm != NULL) {
+    for (size_t k = 0; k <= tpm->size; ++k) {
+      p[k] = tpm->offsets[k];
+    }
+    for (size_t k = 0; k < tpm->nnz; ++k) {
+      i[k] = tpm->columns[k];
+      x[k] = tpm->values[k];
+    }
+    *nnz = tpm->nnz;
+    inform_sparse_tpm_free(tpm);
+  }
+  *err = ierr;
+}
+
+void r_series_to_tpm_k_(int *series, int *nchunks, int *n, int *m, int *b, int *k,
+			double *histories, double *tpm, int *rows, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_history_tpm *htpm = NULL;
+  int *chunk = series;
+  for (int c = 0; c < *nchunks && ierr == INFORM_SUCCESS; ++c) {
+    inform_history_tpm *next = inform_tpm_k(chunk, n[c], m[c], *b, *k, htpm, &ierr);
+    if (next != NULL) {
+      htpm = next;
+    }
+    chunk += n[c] * m[c];
+  }
+  if (ierr == INFORM_SUCCESS) {
+    for (size_t i = 0; i < htpm->rows; ++i) {
+      histories[i] = htpm->histories[i];
+      for (size_t e = htpm->offsets[i]; e < htpm->offsets[i + 1]; ++e) {
+	tpm[i * (*b) + htpm->futures[e]] = htpm->values[e];
+      }
+    }
+    *rows = htpm->rows;
+  }
+  inform_history_tpm_free(htpm);
+  *err = ierr;
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include <inform/utilities/sketch.h>
+
+static inform_qsketch *sketch_import(int k, double *values, int *levels, int size,
+				     inform_error *ierr) {
+  inform_qsketch *sketch = inform_qsketch_alloc(k);
+  if (sketch == NULL) {
+    *ierr = INFORM_ENOMEM;
+    return NULL;
+  }
+  for (int i = 0; i < size && inform_succeeded(ierr); ++i) {
+    inform_qsketch_insert(sketch, values[i], levels[i], ierr);
+  }
+  return sketch;
+}
+
+static void sketch_export(inform_qsketch const *sketch, double *values,
+			  int *levels, int *size, double *counts) {
+  int i = 0;
+  for (size_t h = 0; h < sketch->levels; ++h) {
+    for (size_t j = 0; j < sketch->sizes[h]; ++j, ++i) {
+      values[i] = sketch->items[h][j];
+      levels[i] = (int) h;
+    }
+  }
+  *size   = i;
+  *counts = (double) sketch->counts;
+}
+
+void r_qsketch_max_size_(int *k, int *size) {
+  *size = inform_qsketch_max_size(*k);
+}
+
+void r_qsketch_update_(int *k, double *values, int *levels, int *size,
+		       double *series, int *n, double *counts, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_qsketch *sketch = sketch_import(*k, values, levels, *size, &ierr);
+  if (inform_succeeded(&ierr)) {
+    inform_qsketch_update(sketch, series, *n, &ierr);
+  }
+  if (inform_succeeded(&ierr)) {
+    sketch_export(sketch, values, levels, size, counts);
+  }
+  inform_qsketch_free(sketch);
+  *err = ierr;
+}
+
+void r_qsketch_merge_(int *k, double *values, int *levels, int *size,
+		      double *other_values, int *other_levels, int *other_size,
+		      double *counts, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_qsketch *sketch = sketch_import(*k, values, levels, *size, &ierr);
+  inform_qsketch *other  = sketch_import(*k, other_values, other_levels,
+					 *other_size, &ierr);
+  if (inform_succeeded(&ierr)) {
+    inform_qsketch_merge(sketch, other, &ierr);
+  }
+  if (inform_succeeded(&ierr)) {
+    sketch_export(sketch, values, levels, size, counts);
+  }
+  inform_qsketch_free(other);
+  inform_qsketch_free(sketch);
+  *err = ierr;
+}
+
+void r_qsketch_bounds_(int *k, double *values, int *levels, int *size, int *b,
+		       double *bounds, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_qsketch *sketch = sketch_import(*k, values, levels, *size, &ierr);
+  if (inform_succeeded(&ierr)) {
+    inform_qsketch_bounds(sketch, *b, bounds, &ierr);
+  }
+  inform_qsketch_free(sketch);
+  *err = ierr;
+}
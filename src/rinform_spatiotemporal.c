@@ -0,0 +1,48 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include "inform/spatiotemporal.h"
+
+static inform_lattice r_lattice(int *dims, int *shape, int *boundary) {
+  inform_lattice lattice;
+
+  lattice.dims     = *dims;
+  lattice.shape[0] = shape[0];
+  lattice.shape[1] = (*dims == 2) ? shape[1] : 1;
+  lattice.boundary = (inform_boundary) *boundary;
+  return lattice;
+}
+
+void r_lattice_active_info_(int *series, int *dims, int *shape, int *m, int *b,
+			    int *k, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  int periodic = INFORM_BOUNDARY_PERIODIC;
+  inform_lattice lattice = r_lattice(dims, shape, &periodic);
+
+  inform_lattice_local_active_info(series, &lattice, *m, *b, *k, rval, &ierr);
+  *err  = ierr;
+}
+
+void r_lattice_transfer_entropy_(int *series, int *dims, int *shape, int *boundary,
+				 int *offset, int *m, int *b, int *k, double *rval,
+				 int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_lattice lattice = r_lattice(dims, shape, boundary);
+
+  inform_lattice_local_transfer_entropy(series, &lattice, offset, *m, *b, *k, rval,
+					&ierr);
+  *err  = ierr;
+}
+
+void r_lattice_separable_info_(int *series, int *dims, int *shape, int *boundary,
+			       int *offsets, int *noffsets, int *m, int *b, int *k,
+			       double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_lattice lattice = r_lattice(dims, shape, boundary);
+
+  inform_lattice_local_separable_info(series, &lattice, offsets, *noffsets, *m, *b,
+				      *k, rval, &ierr);
+  *err  = ierr;
+}
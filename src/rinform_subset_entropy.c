@@ -0,0 +1,13 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include "inform/subset_entropy.h"
+
+void r_subset_entropy_(int *series, int *l, int *n, int *b, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_subset_entropy(series, *l, *n, b, rval, &ierr);
+  *err = ierr;
+}
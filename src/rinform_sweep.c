@@ -0,0 +1,22 @@
+/*******************************************************************************/
+// Copyright 2017-2018 Gabriele Valentini, Douglas G. Moore. All rights reserved.
+// Use of this source code is governed by a MIT license that can be found in the
+// LICENSE file.
+/*******************************************************************************/
+#include "inform/sweep.h"
+
+void r_active_info_sweep_(double *series, int *n, int *m, int *bs, int *nb, int *k,
+			  double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_active_info_sweep(series, *n, *m, bs, *nb, *k, rval, &ierr);
+  *err = ierr;
+}
+
+void r_transfer_entropy_sweep_(double *ys, double *xs, int *n, int *m, int *bs,
+			       int *nb, int *k, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_transfer_entropy_sweep(ys, xs, *n, *m, bs, *nb, *k, rval, &ierr);
+  *err = ierr;
+}
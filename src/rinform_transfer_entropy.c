@@ -38,3 +38,23 @@ void r_local_complete_transfer_entropy_(int *ys, int *xs, int *ws, int *l, int *
 }
 
 
+
+void r_transfer_entropy_binned_(double *ys, double *xs, double *ws, int *l, int *n,
+				int *m, int *method, int *b, double *step, double *bounds,
+				int *nbounds, int *k, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+  inform_binning spec = { *method, *b, *step, bounds, *nbounds, 0.0, 0.0 };
+
+  *rval = inform_transfer_entropy_binned(ys, xs, (*l == 0) ? NULL : ws, *l, *n, *m,
+					 &spec, *k, &ierr);
+  *err  = ierr;
+}
+
+void r_transfer_entropy_ensemble_(int *ys, int *xs, int *ws, int *l, int *n, int *m,
+				  int *b, int *k, double *rval, int *err) {
+  inform_error ierr = INFORM_SUCCESS;
+
+  inform_transfer_entropy_ensemble(ys, xs, (*l == 0) ? NULL : ws, *l, *n, *m, *b, *k,
+				   rval, &ierr);
+  *err = ierr;
+}